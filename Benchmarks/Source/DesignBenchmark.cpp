@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    DesignBenchmark.cpp
+    Created: 19 Oct 2026 12:26:08am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "DesignBenchmark.h"
+#include <chrono>
+#include <iostream>
+#include "../../Source/BiquadCoefficients.h"
+
+namespace
+{
+    using Design = BiquadCoefficients (*)(double, double, double, double);
+
+    // ns per call, sweeping the frequency and gain so no two calls are the same design
+    double timePerDesign(Design design)
+    {
+        constexpr int numDesigns = 1000000;
+
+        // keeps the optimiser from throwing the results away
+        volatile double sink {0};
+
+        auto start = std::chrono::steady_clock::now();
+
+        for(int i = 0; i < numDesigns; ++i)
+        {
+            auto frequency = 20.0 + static_cast<double>(i % 19980);
+            auto gainFactor = 0.25 + static_cast<double>(i % 64) * 0.0625;
+            auto coefficients = design(48000.0, frequency, 0.71, gainFactor);
+            sink = sink + coefficients.b0 + coefficients.a1;
+        }
+
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        juce::ignoreUnused(sink);
+
+        return seconds * 1.0e9 / numDesigns;
+    }
+
+    double centreGainDb(Design design, double frequency)
+    {
+        auto coefficients = design(48000.0, frequency, 0.71, juce::Decibels::decibelsToGain(6.0));
+        return juce::Decibels::gainToDecibels(coefficients.getMagnitudeForFrequency(frequency, 48000.0));
+    }
+}
+
+void runDesignBenchmark()
+{
+    std::cout << "\nns per design at 48 kHz, bilinear against matched\n\n";
+    std::cout << "design        bilinear   matched\n";
+
+    std::cout << juce::String("low shelf").paddedRight(' ', 10)
+              << juce::String(timePerDesign(&BiquadCoefficients::makeLowShelf), 2).paddedLeft(' ', 12)
+              << juce::String(timePerDesign(&BiquadCoefficients::makeMatchedLowShelf), 2).paddedLeft(' ', 10) << "\n";
+    std::cout << juce::String("high shelf").paddedRight(' ', 10)
+              << juce::String(timePerDesign(&BiquadCoefficients::makeHighShelf), 2).paddedLeft(' ', 12)
+              << juce::String(timePerDesign(&BiquadCoefficients::makeMatchedHighShelf), 2).paddedLeft(' ', 10) << "\n";
+    std::cout << juce::String("peak").paddedRight(' ', 10)
+              << juce::String(timePerDesign(&BiquadCoefficients::makePeakFilter), 2).paddedLeft(' ', 12)
+              << juce::String(timePerDesign(&BiquadCoefficients::makeMatchedPeakFilter), 2).paddedLeft(' ', 10) << "\n";
+
+    std::cout << "\ngain at the centre of a +6 dB, Q 0.71 peak at 48 kHz\n\n";
+    std::cout << "centre Hz     bilinear   matched\n";
+
+    for(auto frequency : {1000.0, 5000.0, 10000.0, 16000.0, 20000.0})
+    {
+        std::cout << juce::String(frequency, 0).paddedRight(' ', 10)
+                  << juce::String(centreGainDb(&BiquadCoefficients::makePeakFilter, frequency), 2).paddedLeft(' ', 12)
+                  << juce::String(centreGainDb(&BiquadCoefficients::makeMatchedPeakFilter, frequency), 2).paddedLeft(' ', 10) << "\n";
+    }
+}
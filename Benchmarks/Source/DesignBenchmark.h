@@ -0,0 +1,18 @@
+/*
+  ==============================================================================
+
+    DesignBenchmark.h
+    Created: 19 Oct 2026 12:26:08am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Times the bilinear and matched shelf and peak designs per call, which is what a smoothing band
+// pays once per block, and shows how close each one lands to a +6 dB peak's gain at its centre as
+// the centre moves towards Nyquist.
+void runDesignBenchmark();
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    EngineBenchmark.cpp
+    Created: 18 Oct 2026 6:12:08pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "EngineBenchmark.h"
+#include <chrono>
+#include <iostream>
+#include "../../Source/BiquadEngine.h"
+#include "../../Source/HelperFunctions.h"
+
+namespace
+{
+    // same as ChainHelpers::numberOfSections: two 8th order cuts and six single section bands
+    constexpr size_t numberOfSections = 14;
+
+    template <typename SampleType>
+    using Engine = BiquadEngine<SampleType, numberOfSections>;
+
+    // 8th order low cut, low shelf, four peaks, high shelf, 8th order high cut
+    std::vector<BiquadCoefficients> makeEQ(double sampleRate, float lowCutFrequency)
+    {
+        std::vector<BiquadCoefficients> eq;
+
+        auto lowCut = HelperFunctions::designIIRHighpassHighOrderButterworthMethod(lowCutFrequency, sampleRate, 8, 0.71f);
+        for(size_t i = 0; i < lowCut.numSections; ++i)
+            eq.push_back(lowCut.sections[i]);
+
+        eq.push_back(BiquadCoefficients::makeLowShelf(sampleRate, 60.0, 0.71, juce::Decibels::decibelsToGain(4.0)));
+        eq.push_back(BiquadCoefficients::makePeakFilter(sampleRate, 250.0, 1.2, juce::Decibels::decibelsToGain(-3.0)));
+        eq.push_back(BiquadCoefficients::makePeakFilter(sampleRate, 900.0, 2.0, juce::Decibels::decibelsToGain(2.5)));
+        eq.push_back(BiquadCoefficients::makePeakFilter(sampleRate, 3000.0, 0.8, juce::Decibels::decibelsToGain(-1.5)));
+        eq.push_back(BiquadCoefficients::makePeakFilter(sampleRate, 7000.0, 4.0, juce::Decibels::decibelsToGain(6.0)));
+        eq.push_back(BiquadCoefficients::makeHighShelf(sampleRate, 10000.0, 0.71, juce::Decibels::decibelsToGain(-2.0)));
+
+        auto highCut = HelperFunctions::designIIRLowpassHighOrderButterworthMethod(18000.0f, sampleRate, 8, 0.71f);
+        for(size_t i = 0; i < highCut.numSections; ++i)
+            eq.push_back(highCut.sections[i]);
+
+        jassert(eq.size() == numberOfSections);
+        return eq;
+    }
+
+    template <typename SampleType>
+    void loadEngine(Engine<SampleType>& engine, const std::vector<BiquadCoefficients>& eq)
+    {
+        for(size_t section = 0; section < eq.size(); ++section)
+            for(size_t channel = 0; channel < engine.getNumChannels(); ++channel)
+                engine.setCoefficients(section, channel, eq[section]);
+    }
+
+    template <typename SampleType>
+    void fillWithNoise(juce::AudioBuffer<SampleType>& buffer, juce::Random& random)
+    {
+        for(int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for(int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, static_cast<SampleType>(random.nextFloat() * 2.0f - 1.0f) * static_cast<SampleType>(0.5));
+    }
+
+    // ns per sample per channel for a stream of the given length.  With automation on every block
+    // ramps the low cut to a new frequency, which is the worst case for the engine.
+    template <typename SampleType>
+    double timeEngine(double sampleRate, int blockSize, bool automate, int numChannels = 2)
+    {
+        Engine<SampleType> engine;
+        engine.prepare(blockSize, numChannels);
+        loadEngine(engine, makeEQ(sampleRate, 30.0f));
+        engine.reset();
+
+        juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+        juce::Random random(1);
+        fillWithNoise(buffer, random);
+
+        auto numBlocks = juce::jmax(1, static_cast<int>(sampleRate * 10.0) / blockSize);
+        double seconds = 0.0;
+
+        for(int block = 0; block < numBlocks; ++block)
+        {
+            if(automate)
+                loadEngine(engine, makeEQ(sampleRate, 30.0f + static_cast<float>(block % 64)));
+
+            auto start = std::chrono::steady_clock::now();
+            engine.process(buffer.getArrayOfWritePointers(), static_cast<size_t>(numChannels), 0, blockSize);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        return seconds * 1.0e9 / (static_cast<double>(numBlocks) * blockSize * numChannels);
+    }
+
+    // runs the same noise through a float and a double engine holding just the low cut, and returns the
+    // level of the difference relative to the double output, in dB.
+    double measureFloatError(double sampleRate, float lowCutFrequency)
+    {
+        auto lowCut = HelperFunctions::designIIRHighpassHighOrderButterworthMethod(lowCutFrequency, sampleRate, 8, 0.71f);
+
+        Engine<float> floatEngine;
+        Engine<double> doubleEngine;
+        constexpr int blockSize = 512;
+        floatEngine.prepare(blockSize);
+        doubleEngine.prepare(blockSize);
+
+        for(size_t section = 0; section < lowCut.numSections; ++section)
+        {
+            floatEngine.setCoefficients(section, 0, lowCut.sections[section]);
+            doubleEngine.setCoefficients(section, 0, lowCut.sections[section]);
+        }
+
+        floatEngine.reset();
+        doubleEngine.reset();
+
+        juce::AudioBuffer<float> floatBuffer(1, blockSize);
+        juce::AudioBuffer<double> doubleBuffer(1, blockSize);
+        juce::Random random(2);
+
+        double signal = 0.0, error = 0.0;
+        auto numBlocks = static_cast<int>(sampleRate * 5.0) / blockSize;
+
+        for(int block = 0; block < numBlocks; ++block)
+        {
+            fillWithNoise(doubleBuffer, random);
+            floatBuffer.makeCopyOf(doubleBuffer);
+
+            floatEngine.process(floatBuffer.getArrayOfWritePointers(), 1, 0, blockSize);
+            doubleEngine.process(doubleBuffer.getArrayOfWritePointers(), 1, 0, blockSize);
+
+            // skip the first second while the filters settle
+            if(block * blockSize < sampleRate)
+                continue;
+
+            for(int i = 0; i < blockSize; ++i)
+            {
+                auto reference = doubleBuffer.getSample(0, i);
+                auto difference = static_cast<double>(floatBuffer.getSample(0, i)) - reference;
+                signal += reference * reference;
+                error += difference * difference;
+            }
+        }
+
+        return 10.0 * std::log10(error / signal);
+    }
+}
+
+void runEngineBenchmark()
+{
+    const double sampleRates[] = {44100.0, 48000.0, 96000.0, 192000.0};
+    const int blockSizes[] = {64, 512};
+
+    std::cout << "ns per sample per channel, full 14 section EQ in stereo\n\n";
+    std::cout << "rate      block  automation    float   double   ratio\n";
+
+    for(auto sampleRate : sampleRates)
+    {
+        for(auto blockSize : blockSizes)
+        {
+            for(auto automate : {false, true})
+            {
+                auto floatTime = timeEngine<float>(sampleRate, blockSize, automate);
+                auto doubleTime = timeEngine<double>(sampleRate, blockSize, automate);
+
+                std::cout << juce::String(sampleRate, 0).paddedRight(' ', 10)
+                          << juce::String(blockSize).paddedRight(' ', 7)
+                          << juce::String(automate ? "on" : "off").paddedRight(' ', 12)
+                          << juce::String(floatTime, 2).paddedLeft(' ', 7)
+                          << juce::String(doubleTime, 2).paddedLeft(' ', 9)
+                          << juce::String(doubleTime / floatTime, 2).paddedLeft(' ', 8) << "\n";
+            }
+        }
+    }
+
+    // a channel per lane, so a wide bus should cost about as many times stereo as it fills registers
+    std::cout << "\nns per sample for the whole bus, full EQ at 48 kHz, 512 sample blocks\n\n";
+    std::cout << "channels     float   double   float x stereo\n";
+
+    auto stereoTime = 2.0 * timeEngine<float>(48000.0, 512, false);
+
+    for(auto numChannels : {1, 2, 6, 12, 16})
+    {
+        auto floatTime = numChannels * timeEngine<float>(48000.0, 512, false, numChannels);
+        auto doubleTime = numChannels * timeEngine<double>(48000.0, 512, false, numChannels);
+
+        std::cout << juce::String(numChannels).paddedRight(' ', 10)
+                  << juce::String(floatTime, 2).paddedLeft(' ', 8)
+                  << juce::String(doubleTime, 2).paddedLeft(' ', 9)
+                  << juce::String(floatTime / stereoTime, 2).paddedLeft(' ', 17) << "\n";
+    }
+
+    std::cout << "\nfloat engine error relative to double, 8th order low cut\n\n";
+    std::cout << "rate      cutoff    error dB\n";
+
+    for(auto sampleRate : sampleRates)
+    {
+        for(auto frequency : {20.0f, 80.0f})
+        {
+            std::cout << juce::String(sampleRate, 0).paddedRight(' ', 10)
+                      << juce::String(frequency, 0).paddedRight(' ', 10)
+                      << juce::String(measureFloatError(sampleRate, frequency), 1).paddedLeft(' ', 8) << "\n";
+        }
+    }
+}
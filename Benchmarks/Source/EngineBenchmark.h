@@ -0,0 +1,18 @@
+/*
+  ==============================================================================
+
+    EngineBenchmark.h
+    Created: 18 Oct 2026 6:12:08pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Times the float and the double filter engine against each other with a full, realistic EQ
+// loaded into both lanes, and shows what the extra cost buys: how far the float engine's output
+// drifts from the double one on the filters that suffer most from rounding.
+void runEngineBenchmark();
@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+    FifoBenchmark.cpp
+    Created: 19 Oct 2026 5:31:08am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "FifoBenchmark.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "../../Source/Fifo.h"
+#include "../../Source/SpscRing.h"
+#include "../../Source/MeterValues.h"
+
+namespace
+{
+    // the plugin's depths and sizes
+    constexpr size_t meterDepth = 30;
+    constexpr size_t analyzerDepth = 100;
+    constexpr int analyzerBufferSize = 2048;
+    constexpr int fftSize = 8192;
+    constexpr int numPathPoints = 1000;
+
+    constexpr int numHandOffs = 20000;
+
+    // ns per value of producing one and consuming it straight away
+    template <typename Produce, typename Consume>
+    double timeHandOffs(Produce&& produce, Consume&& consume)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for(int i = 0; i < numHandOffs; ++i)
+        {
+            produce(i);
+            consume();
+        }
+
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return seconds * 1.0e9 / numHandOffs;
+    }
+
+    MeterValues makeMeterValues(int i)
+    {
+        MeterValues values;
+        values.leftPeakDb.setGain(static_cast<float>(i & 255) / 256.0f);
+        values.rightPeakDb = values.leftPeakDb;
+        return values;
+    }
+
+    template <typename Queue>
+    double timeMeterValues()
+    {
+        Queue queue;
+        MeterValues values;
+        volatile float sink {0};
+
+        return timeHandOffs([&](int i) { queue.push(makeMeterValues(i)); },
+                            [&]
+                            {
+                                queue.pull(values);
+                                sink = values.leftPeakDb.getDb();
+                            });
+    }
+
+    // pushing and pulling on two threads at once, with the queue full or empty as often as not
+    template <typename Queue>
+    double timeMeterValuesAcrossThreads()
+    {
+        Queue queue;
+        constexpr int numValues = 1000000;
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::thread producer([&queue]
+        {
+            for(int i = 0; i < numValues; ++i)
+                while(! queue.push(makeMeterValues(i)))
+                    std::this_thread::yield();
+        });
+
+        MeterValues values;
+        for(int received = 0; received < numValues;)
+        {
+            if(queue.pull(values))
+                ++received;
+            else
+                std::this_thread::yield();
+        }
+
+        producer.join();
+
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return seconds * 1.0e9 / numValues;
+    }
+
+    // SingleChannelSampleFifo filled bufferToFill and pushed a copy, PathProducer pulled another
+    double timeSampleBuffersFifo(const std::vector<float>& noise)
+    {
+        Fifo<juce::AudioBuffer<float>, analyzerDepth> fifo;
+        fifo.prepare(analyzerBufferSize, 1);
+
+        juce::AudioBuffer<float> bufferToFill(1, analyzerBufferSize), pulled(1, analyzerBufferSize), generator(1, analyzerBufferSize);
+
+        return timeHandOffs([&](int)
+                            {
+                                bufferToFill.copyFrom(0, 0, noise.data(), analyzerBufferSize);
+                                fifo.push(bufferToFill);
+                            },
+                            [&]
+                            {
+                                fifo.pull(pulled);
+                                generator.copyFrom(0, 0, pulled, 0, 0, analyzerBufferSize);
+                            });
+    }
+
+    // now the samples go straight into a slot and are read from it
+    double timeSampleBuffersRing(const std::vector<float>& noise)
+    {
+        SpscRing<juce::AudioBuffer<float>, analyzerDepth> ring;
+        ring.prepare([](juce::AudioBuffer<float>& slot) { slot.setSize(1, analyzerBufferSize); });
+
+        juce::AudioBuffer<float> generator(1, analyzerBufferSize);
+
+        return timeHandOffs([&](int)
+                            {
+                                auto* slot = ring.claim();
+                                slot->copyFrom(0, 0, noise.data(), analyzerBufferSize);
+                                ring.commit();
+                            },
+                            [&]
+                            {
+                                generator.copyFrom(0, 0, *ring.front(), 0, 0, analyzerBufferSize);
+                                ring.pop();
+                            });
+    }
+
+    // FFTDataGenerator worked in its own vector and pushed a copy, PathProducer exchanged it into a new
+    // empty one, which copied and allocated
+    double timeFFTDataFifo(const std::vector<float>& noise)
+    {
+        Fifo<std::vector<float>, analyzerDepth> fifo;
+        fifo.prepare(2 * fftSize);
+
+        std::vector<float> fftData(2 * fftSize);
+        volatile float sink {0};
+
+        return timeHandOffs([&](int)
+                            {
+                                std::copy(noise.begin(), noise.begin() + fftSize, fftData.begin());
+                                fifo.push(fftData);
+                            },
+                            [&]
+                            {
+                                std::vector<float> pulled;
+                                fifo.exchange(pulled);
+                                sink = pulled[fftSize / 2];
+                            });
+    }
+
+    double timeFFTDataRing(const std::vector<float>& noise)
+    {
+        SpscRing<std::vector<float>, analyzerDepth> ring;
+        ring.prepare([](std::vector<float>& slot) { slot.assign(2 * fftSize, 0.0f); });
+
+        volatile float sink {0};
+
+        return timeHandOffs([&](int)
+                            {
+                                auto* slot = ring.claim();
+                                std::copy(noise.begin(), noise.begin() + fftSize, slot->begin());
+                                ring.commit();
+                            },
+                            [&]
+                            {
+                                sink = (*ring.front())[fftSize / 2];
+                                ring.pop();
+                            });
+    }
+
+    void buildPath(juce::Path& path, const std::vector<float>& noise)
+    {
+        path.startNewSubPath(0.0f, noise[0]);
+
+        for(int i = 1; i < numPathPoints; ++i)
+            path.lineTo(static_cast<float>(i), noise[static_cast<size_t>(i)]);
+    }
+
+    // AnalyzerPathGenerator built a new path and pushed a copy, the analyzer pulled another
+    double timePathsFifo(const std::vector<float>& noise)
+    {
+        Fifo<juce::Path, analyzerDepth> fifo;
+        juce::Path pulled;
+
+        return timeHandOffs([&](int)
+                            {
+                                juce::Path path;
+                                buildPath(path, noise);
+                                fifo.push(path);
+                            },
+                            [&] { fifo.pull(pulled); });
+    }
+
+    // now it's built in a slot that keeps its storage, and swapped with the analyzer's
+    double timePathsRing(const std::vector<float>& noise)
+    {
+        SpscRing<juce::Path, analyzerDepth> ring;
+        juce::Path pulled;
+
+        return timeHandOffs([&](int)
+                            {
+                                auto* slot = ring.claim();
+                                slot->clear();
+                                buildPath(*slot, noise);
+                                ring.commit();
+                            },
+                            [&] { ring.exchange(pulled); });
+    }
+
+    void printRow(const juce::String& site, double fifoTime, double ringTime)
+    {
+        std::cout << site.paddedRight(' ', 26)
+                  << juce::String(fifoTime, 1).paddedLeft(' ', 10)
+                  << juce::String(ringTime, 1).paddedLeft(' ', 10)
+                  << juce::String(fifoTime / ringTime, 2).paddedLeft(' ', 9) << "\n";
+    }
+}
+
+void runFifoBenchmark()
+{
+    std::vector<float> noise(static_cast<size_t>(fftSize));
+    juce::Random random(4);
+
+    for(auto& sample : noise)
+        sample = random.nextFloat() - 0.5f;
+
+    std::cout << "\nns per value handed off, Fifo against SpscRing\n\n";
+    std::cout << "site                          Fifo  SpscRing  speedup\n";
+
+    using MeterFifo = Fifo<MeterValues, meterDepth>;
+    using MeterRing = SpscRing<MeterValues, meterDepth>;
+
+    printRow("meter values", timeMeterValues<MeterFifo>(), timeMeterValues<MeterRing>());
+    printRow("meter values, 2 threads", timeMeterValuesAcrossThreads<MeterFifo>(), timeMeterValuesAcrossThreads<MeterRing>());
+    printRow("analyzer sample buffers", timeSampleBuffersFifo(noise), timeSampleBuffersRing(noise));
+    printRow("analyzer FFT data", timeFFTDataFifo(noise), timeFFTDataRing(noise));
+    printRow("analyzer paths", timePathsFifo(noise), timePathsRing(noise));
+}
@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    FifoBenchmark.h
+    Created: 19 Oct 2026 5:31:08am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Times the hand off at each place the plugin queues data between threads, with the old copying Fifo
+// and with SpscRing the way each site now uses it: meter values, the analyzer's sample buffers, its
+// FFT blocks and its paths.  Both sides run on one thread, one value at a time, so it's the cost of
+// the queue and the copies.  The meter values also go across two threads, where the padding counts.
+void runFifoBenchmark();
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 7:02:51pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "DesignBenchmark.h"
+#include "EngineBenchmark.h"
+#include "FifoBenchmark.h"
+#include "ProcessorBenchmark.h"
+#include "TruePeakBenchmark.h"
+#include "../../Source/GlobalParameters.h"
+#include "../../Source/RealtimeAudit.h"
+
+// ParametricEQBenchmark [--engine] [--processor] [--truepeak] [--design] [--fifo] [--double] [--editor] [--csv] [--seconds=N]
+//                       [--oversampling=0|1|2] [--linear]
+// ParametricEQBenchmark --audit [--double]
+// ParametricEQBenchmark --mono [--double] [--editor] [--seconds=N]
+//
+// With none of --engine, --processor, --truepeak, --design or --fifo all of them run.  Build it in Release, the
+// numbers from a debug build mean nothing.  --audit runs processBlock under RealtimeAudit instead and exits
+// with 1 if anything on the audio thread allocated or locked, so it can gate a build.  It needs the Audit
+// configuration, Release with the audit compiled in, which is no good for timing.  --mono checks
+// a mono bus against the left of a stereo one and exits with 1 if they differ.
+// --oversampling runs the processor with the filters at 2x (1) or 4x (2) the host rate, to compare
+// against the base path (0, the default).  --linear runs the linear phase FIR path instead, and exits
+// with 1 if any run missed a convolution partition.
+int main(int argc, char* argv[])
+{
+    // the processor's parameter state wants a message manager, even though no message loop runs.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    auto runEngine = args.containsOption("--engine");
+    auto runProcessor = args.containsOption("--processor");
+    auto runTruePeak = args.containsOption("--truepeak");
+    auto runDesign = args.containsOption("--design");
+    auto runFifo = args.containsOption("--fifo");
+
+    if(! runEngine && ! runProcessor && ! runTruePeak && ! runDesign && ! runFifo)
+        runEngine = runProcessor = runTruePeak = runDesign = runFifo = true;
+
+    ProcessorBenchmarkOptions options;
+    options.doublePrecision = args.containsOption("--double");
+    options.editorActive = args.containsOption("--editor");
+    options.csv = args.containsOption("--csv");
+    
+    if(args.containsOption("--seconds"))
+        options.secondsPerRun = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+    if(args.containsOption("--audit"))
+    {
+        auto numViolations = runRealtimeAudit(options);
+        std::cout.flush();
+        return numViolations == 0 ? 0 : 1;
+    }
+
+    if(args.containsOption("--mono"))
+    {
+        auto numMismatches = runMonoCheck(options);
+        std::cout.flush();
+        return numMismatches == 0 ? 0 : 1;
+    }
+
+    if(args.containsOption("--oversampling"))
+        options.oversamplingOrder = juce::jlimit(0, GlobalParameters::maxOversamplingOrder,
+                                                 args.getValueForOption("--oversampling").getIntValue());
+
+    options.linearPhase = args.containsOption("--linear");
+
+    if(RealtimeAudit::isCompiledIn())
+        std::cout << "built with REALTIME_AUDIT, the timings include its bookkeeping\n";
+
+    if(runEngine && ! options.csv)
+        runEngineBenchmark();
+
+    if(runTruePeak && ! options.csv)
+        runTruePeakBenchmark();
+
+    if(runDesign && ! options.csv)
+        runDesignBenchmark();
+
+    if(runFifo && ! options.csv)
+        runFifoBenchmark();
+
+    auto numFailures = runProcessor ? runProcessorBenchmark(options) : 0;
+
+    std::cout.flush();
+    return numFailures == 0 ? 0 : 1;
+}
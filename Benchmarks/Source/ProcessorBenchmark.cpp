@@ -0,0 +1,457 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmark.cpp
+    Created: 18 Oct 2026 7:02:51pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "ProcessorBenchmark.h"
+#include <algorithm>
+#include <iostream>
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/GlobalParameters.h"
+#include "../../Source/RealtimeAudit.h"
+
+namespace
+{
+    struct BandSetting
+    {
+        ChainPosition position;
+        float frequency;
+        float gainOrSlope;      // dB for the parametric bands, the slope choice index for the cuts
+        bool isCut;
+    };
+
+    // a busy but plausible mix EQ, both cuts at 48 dB/Oct
+    const BandSetting bandSettings[]
+    {
+        {ChainPosition::LowCut, 30.0f, 7.0f, true},
+        {ChainPosition::LowShelf, 90.0f, 3.0f, false},
+        {ChainPosition::PeakFilter1, 250.0f, -2.5f, false},
+        {ChainPosition::PeakFilter2, 1000.0f, 1.5f, false},
+        {ChainPosition::PeakFilter3, 3500.0f, -3.0f, false},
+        {ChainPosition::PeakFilter4, 8000.0f, 2.0f, false},
+        {ChainPosition::HighShelf, 12000.0f, -1.5f, false},
+        {ChainPosition::HighCut, 18000.0f, 7.0f, true}
+    };
+
+    const ChannelMode channelModes[] {ChannelMode::Stereo, ChannelMode::DualMono, ChannelMode::MidSide};
+    const double sampleRates[] {44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0};
+    const int blockSizes[] {16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+
+    // automated bands sweep half an octave and 3 dB either side of their setting, once every two seconds.
+    constexpr double sweepRate {0.5};
+
+    void setParameter(juce::AudioProcessorValueTreeState& apvts, const juce::String& name, float value)
+    {
+        auto* param = apvts.getParameter(name);
+        jassert(param != nullptr);
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    void switchOnBands(juce::AudioProcessorValueTreeState& apvts)
+    {
+        for(auto channel : {Channel::Left, Channel::Right})
+        {
+            for(const auto& band : bandSettings)
+            {
+                setParameter(apvts, createBypassParamString(channel, band.position), 0.0f);
+
+                if(band.isCut)
+                    setParameter(apvts, createSlopeParamString(channel, band.position), band.gainOrSlope);
+            }
+        }
+    }
+
+    // sweep runs from -1 to 1.  The right channel sits a little higher, so dual mono and mid side
+    // really are two different EQs.
+    void setBands(juce::AudioProcessorValueTreeState& apvts, float sweep)
+    {
+        for(auto channel : {Channel::Left, Channel::Right})
+        {
+            auto offset = channel == Channel::Right ? 1.1f : 1.0f;
+
+            for(const auto& band : bandSettings)
+            {
+                auto frequency = juce::jlimit(20.0f, 20000.0f, band.frequency * offset * std::exp2(0.5f * sweep));
+                setParameter(apvts, createFreqParamString(channel, band.position), frequency);
+
+                if(! band.isCut)
+                    setParameter(apvts, createGainParamString(channel, band.position), band.gainOrSlope + 3.0f * sweep);
+            }
+        }
+    }
+
+    struct RunResult
+    {
+        double nsPerSample;                         // mean, per stereo sample frame
+        double median, p99, p999, worst;            // block times in microseconds
+        double worstBudgetPercent;                  // worst block against the time the block lasts
+        int latencySamples;
+        int latePartitions, missedPartitions;       // the convolution workers', in linear phase
+    };
+
+    RunResult summarise(std::vector<double>& blockSeconds, int blockSize, double sampleRate)
+    {
+        jassert(! blockSeconds.empty());
+
+        double total = 0.0;
+        for(auto seconds : blockSeconds)
+            total += seconds;
+
+        std::sort(blockSeconds.begin(), blockSeconds.end());
+
+        auto percentile = [&blockSeconds](double p)
+        {
+            auto index = static_cast<size_t>(p * static_cast<double>(blockSeconds.size() - 1) + 0.5);
+            return blockSeconds[std::min(index, blockSeconds.size() - 1)] * 1.0e6;
+        };
+
+        RunResult result;
+        result.nsPerSample = total * 1.0e9 / (static_cast<double>(blockSeconds.size()) * blockSize);
+        result.median = percentile(0.5);
+        result.p99 = percentile(0.99);
+        result.p999 = percentile(0.999);
+        result.worst = blockSeconds.back() * 1.0e6;
+        result.worstBudgetPercent = 100.0 * blockSeconds.back() * sampleRate / blockSize;
+        return result;
+    }
+
+    // every band on and at its setting, on a bus of numChannels, ready for the first block
+    template <typename SampleType>
+    void setUpProcessor(ParametricEQAudioProcessor& processor, const ProcessorBenchmarkOptions& options, ChannelMode mode,
+                        int numChannels, double sampleRate, int blockSize)
+    {
+        processor.setProcessingPrecision(std::is_same<SampleType, double>::value ? juce::AudioProcessor::doublePrecision
+                                                                                  : juce::AudioProcessor::singlePrecision);
+        processor.editorActive = options.editorActive;
+
+        auto& apvts = processor.apvts;
+        setParameter(apvts, GlobalParameters::processingModeName, static_cast<float>(mode));
+        setParameter(apvts, GlobalParameters::oversamplingName, static_cast<float>(options.oversamplingOrder));
+        setParameter(apvts, GlobalParameters::phaseModeName, options.linearPhase ? 1.0f : 0.0f);
+        switchOnBands(apvts);
+        setBands(apvts, 0.0f);
+
+        processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+        jassert(processor.getTotalNumOutputChannels() == numChannels);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    template <typename SampleType>
+    RunResult runOnce(const ProcessorBenchmarkOptions& options, ChannelMode mode, double sampleRate, int blockSize, bool automate,
+                      int numChannels = 2)
+    {
+        ParametricEQAudioProcessor processor;
+        setUpProcessor<SampleType>(processor, options, mode, numChannels, sampleRate, blockSize);
+        auto& apvts = processor.apvts;
+
+        // a second of noise at -6 dB, played round and round.  Never silent, so the processor never sleeps.
+        juce::AudioBuffer<SampleType> noise(numChannels, juce::jmax(blockSize, static_cast<int>(sampleRate)));
+        juce::Random random(1);
+
+        for(int channel = 0; channel < noise.getNumChannels(); ++channel)
+            for(int i = 0; i < noise.getNumSamples(); ++i)
+                noise.setSample(channel, i, static_cast<SampleType>(random.nextFloat() - 0.5f));
+
+        juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+
+        auto numBlocks = juce::jmax(16, static_cast<int>(options.secondsPerRun * sampleRate) / blockSize);
+        auto numWarmUpBlocks = juce::jmax(4, numBlocks / 10);
+
+        std::vector<double> blockSeconds;
+        blockSeconds.reserve(static_cast<size_t>(numBlocks));
+
+        // prepareToPlay makes the first kernels, but the first block asks for them again, every band
+        // counts as changed, so let the worker finish and the fade settle before timing.  Blocks come
+        // faster than real time here, so most of the convolution worker's partitions are late, and the
+        // times include the audio thread doing them or waiting for them.  None should be missed.
+        if(options.linearPhase)
+        {
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+            juce::Thread::sleep(200);
+        }
+        
+        auto phaseStep = juce::MathConstants<double>::twoPi * sweepRate * blockSize / sampleRate;
+        double phase = 0.0;
+        int noisePosition = 0;
+
+        for(int block = -numWarmUpBlocks; block < numBlocks; ++block)
+        {
+            // hosts set automated parameters between blocks, so this stays outside the timing.
+            if(automate)
+            {
+                setBands(apvts, static_cast<float>(std::sin(phase)));
+                phase += phaseStep;
+            }
+
+            for(int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.copyFrom(channel, 0, noise, channel, noisePosition, blockSize);
+
+            noisePosition += blockSize;
+            if(noisePosition + blockSize > noise.getNumSamples())
+                noisePosition = 0;
+
+            auto start = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midi);
+            auto end = juce::Time::getHighResolutionTicks();
+
+            if(block >= 0)
+                blockSeconds.push_back(juce::Time::highResolutionTicksToSeconds(end - start));
+        }
+
+        auto result = summarise(blockSeconds, blockSize, sampleRate);
+        result.latencySamples = processor.getLatencySamples();
+        result.latePartitions = processor.getLinearPhaseFilter().getNumLatePartitions();
+        result.missedPartitions = processor.getLinearPhaseFilter().getNumMissedPartitions();
+
+        processor.releaseResources();
+        return result;
+    }
+
+    template <typename SampleType>
+    int runAll(const ProcessorBenchmarkOptions& options)
+    {
+        juce::String precision = std::is_same<SampleType, double>::value ? "double" : "float";
+        auto oversampling = GlobalParameters::oversamplingChoices[options.oversamplingOrder];
+        juce::String phase = options.linearPhase ? "linear" : "minimum";
+        int failures = 0;
+
+        if(options.csv)
+            std::cout << "precision,oversampling,phase,mode,sampleRate,blockSize,automation,nsPerSample,medianUs,p99Us,p999Us,worstUs,worstBudgetPercent,latencySamples,latePartitions,missedPartitions\n";
+
+        for(auto mode : channelModes)
+        {
+            if(! options.csv)
+            {
+                std::cout << "\n" << mapModeToString.at(mode) << ", " << precision << ", oversampling " << oversampling
+                          << ", " << phase << " phase" << (options.editorActive ? ", editor open" : "") << "\n\n";
+                std::cout << "rate      block  automation   ns/sample   median us   p99 us   p99.9 us   worst us   worst % budget   latency"
+                          << (options.linearPhase ? "      late   missed" : "") << "\n";
+            }
+
+            for(auto sampleRate : sampleRates)
+            {
+                for(auto blockSize : blockSizes)
+                {
+                    for(auto automate : {false, true})
+                    {
+                        auto result = runOnce<SampleType>(options, mode, sampleRate, blockSize, automate);
+                        failures += result.missedPartitions > 0 ? 1 : 0;
+
+                        if(options.csv)
+                        {
+                            std::cout << precision << "," << oversampling << "," << phase << "," << mapModeToString.at(mode) << ","
+                                      << sampleRate << "," << blockSize << "," << (automate ? "on" : "off") << ","
+                                      << result.nsPerSample << "," << result.median << "," << result.p99 << ","
+                                      << result.p999 << "," << result.worst << "," << result.worstBudgetPercent << ","
+                                      << result.latencySamples << "," << result.latePartitions << ","
+                                      << result.missedPartitions << "\n";
+                        }
+                        else
+                        {
+                            std::cout << juce::String(sampleRate, 0).paddedRight(' ', 10)
+                                      << juce::String(blockSize).paddedRight(' ', 7)
+                                      << juce::String(automate ? "on" : "off").paddedRight(' ', 11)
+                                      << juce::String(result.nsPerSample, 1).paddedLeft(' ', 11)
+                                      << juce::String(result.median, 2).paddedLeft(' ', 12)
+                                      << juce::String(result.p99, 2).paddedLeft(' ', 9)
+                                      << juce::String(result.p999, 2).paddedLeft(' ', 11)
+                                      << juce::String(result.worst, 2).paddedLeft(' ', 11)
+                                      << juce::String(result.worstBudgetPercent, 2).paddedLeft(' ', 17)
+                                      << juce::String(result.latencySamples).paddedLeft(' ', 10);
+
+                            if(options.linearPhase)
+                                std::cout << juce::String(result.latePartitions).paddedLeft(' ', 10)
+                                          << juce::String(result.missedPartitions).paddedLeft(' ', 9)
+                                          << (result.missedPartitions > 0 ? "   MISSED" : "");
+
+                            std::cout << "\n";
+                        }
+                    }
+                }
+            }
+        }
+
+        // A partition is only missed when it's due in the block it was handed over in, which sizing the
+        // convolver for the largest block rules out however slow the machine.
+        if(options.linearPhase && ! options.csv)
+            std::cout << "\nlinear phase: " << failures << " runs with missed partitions\n";
+
+        return failures;
+    }
+
+    // The smallest, a common and the largest block, all automated so the coefficient updates run too,
+    // once with the editor closed and once with the meters and the analyzer being fed, at every
+    // oversampling factor and then in linear phase.
+    template <typename SampleType>
+    void runAllUnderAudit(const ProcessorBenchmarkOptions& options)
+    {
+        auto auditOptions = options;
+        auditOptions.secondsPerRun = 1.0;
+
+        const std::pair<double, int> settings[] {{44100.0, 16}, {48000.0, 512}, {192000.0, 4096}};
+
+        for(auto editorActive : {false, true})
+        {
+            auditOptions.editorActive = editorActive;
+
+            for(int order = 0; order <= GlobalParameters::maxOversamplingOrder; ++order)
+            {
+                auditOptions.oversamplingOrder = order;
+
+                for(auto mode : channelModes)
+                    for(const auto& [sampleRate, blockSize] : settings)
+                        runOnce<SampleType>(auditOptions, mode, sampleRate, blockSize, true);
+            }
+            
+            auditOptions.oversamplingOrder = 0;
+            auditOptions.linearPhase = true;
+            
+            for(auto mode : channelModes)
+                for(const auto& [sampleRate, blockSize] : settings)
+                    runOnce<SampleType>(auditOptions, mode, sampleRate, blockSize, true);
+            
+            auditOptions.linearPhase = false;
+        }
+    }
+
+    // The same automated noise through a mono processor and through both sides of a stereo one, which
+    // runs the left parameters on both.  Returns the largest difference between the mono output and
+    // the stereo left, which should be none at all, every stage works on each channel on its own.
+    template <typename SampleType>
+    double compareMonoWithStereo(const ProcessorBenchmarkOptions& options, double sampleRate, int blockSize)
+    {
+        ParametricEQAudioProcessor mono, stereo;
+        setUpProcessor<SampleType>(mono, options, ChannelMode::Stereo, 1, sampleRate, blockSize);
+        setUpProcessor<SampleType>(stereo, options, ChannelMode::Stereo, 2, sampleRate, blockSize);
+
+        juce::AudioBuffer<SampleType> monoBuffer(1, blockSize), stereoBuffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(3);
+
+        auto numBlocks = juce::jmax(16, static_cast<int>(options.secondsPerRun * sampleRate) / blockSize);
+        auto phaseStep = juce::MathConstants<double>::twoPi * sweepRate * blockSize / sampleRate;
+        double phase = 0.0;
+        double largest = 0.0;
+
+        for(int block = 0; block < numBlocks; ++block)
+        {
+            auto sweep = static_cast<float>(std::sin(phase));
+            setBands(mono.apvts, sweep);
+            setBands(stereo.apvts, sweep);
+            phase += phaseStep;
+
+            for(int i = 0; i < blockSize; ++i)
+            {
+                auto sample = static_cast<SampleType>(random.nextFloat() - 0.5f);
+                monoBuffer.setSample(0, i, sample);
+                stereoBuffer.setSample(0, i, sample);
+                stereoBuffer.setSample(1, i, sample);
+            }
+
+            mono.processBlock(monoBuffer, midi);
+            stereo.processBlock(stereoBuffer, midi);
+
+            for(int i = 0; i < blockSize; ++i)
+            {
+                auto difference = static_cast<double>(monoBuffer.getSample(0, i)) - static_cast<double>(stereoBuffer.getSample(0, i));
+                largest = juce::jmax(largest, std::abs(difference));
+            }
+        }
+
+        mono.releaseResources();
+        stereo.releaseResources();
+        return largest;
+    }
+
+    template <typename SampleType>
+    int runMonoCheckAt(const ProcessorBenchmarkOptions& options)
+    {
+        auto checkOptions = options;
+        checkOptions.secondsPerRun = juce::jmin(options.secondsPerRun, 2.0);
+        checkOptions.linearPhase = false;
+
+        const std::pair<double, int> settings[] {{44100.0, 16}, {48000.0, 512}, {192000.0, 4096}};
+        int failures = 0;
+
+        std::cout << "mono against stereo left, automated\n\n";
+        std::cout << "oversampling   rate      block   largest difference\n";
+
+        for(int order = 0; order <= GlobalParameters::maxOversamplingOrder; ++order)
+        {
+            checkOptions.oversamplingOrder = order;
+
+            for(const auto& [sampleRate, blockSize] : settings)
+            {
+                auto difference = compareMonoWithStereo<SampleType>(checkOptions, sampleRate, blockSize);
+                failures += difference > 0.0 ? 1 : 0;
+
+                std::cout << GlobalParameters::oversamplingChoices[order].paddedRight(' ', 15)
+                          << juce::String(sampleRate, 0).paddedRight(' ', 10)
+                          << juce::String(blockSize).paddedRight(' ', 8)
+                          << juce::String(difference, 10).paddedLeft(' ', 20) << (difference > 0.0 ? "   MISMATCH" : "") << "\n";
+            }
+        }
+
+        // what the mono path saves, the filters themselves run a SIMD register either way
+        checkOptions.oversamplingOrder = options.oversamplingOrder;
+        auto monoTime = runOnce<SampleType>(checkOptions, ChannelMode::Stereo, 48000.0, 512, true, 1).nsPerSample;
+        auto stereoTime = runOnce<SampleType>(checkOptions, ChannelMode::Stereo, 48000.0, 512, true, 2).nsPerSample;
+
+        std::cout << "\nns/sample at 48 kHz, 512 sample blocks, automated: mono " << juce::String(monoTime, 1)
+                  << ", stereo " << juce::String(stereoTime, 1) << ", ratio " << juce::String(monoTime / stereoTime, 2) << "\n";
+
+        std::cout << "\nmono check: " << failures << " mismatches\n";
+        return failures;
+    }
+}
+
+int runProcessorBenchmark(const ProcessorBenchmarkOptions& options)
+{
+    if(options.doublePrecision)
+        return runAll<double>(options);
+
+    return runAll<float>(options);
+}
+
+int runRealtimeAudit(const ProcessorBenchmarkOptions& options)
+{
+    if(! RealtimeAudit::isCompiledIn())
+    {
+        std::cout << "built without REALTIME_AUDIT, nothing to check.  Build the Audit configuration.\n";
+        return -1;
+    }
+
+    RealtimeAudit::clearViolations();
+
+    if(options.doublePrecision)
+        runAllUnderAudit<double>(options);
+    else
+        runAllUnderAudit<float>(options);
+
+    auto violations = RealtimeAudit::getViolations();
+
+    for(const auto& violation : violations)
+    {
+        std::cout << "\n" << RealtimeAudit::getTypeName(violation.type) << " on the audio thread, "
+                  << violation.count << (violation.count == 1 ? " time\n" : " times\n")
+                  << violation.stackTrace << "\n";
+    }
+
+    std::cout << "\nreal time audit: " << violations.size() << " distinct violations\n";
+    return static_cast<int>(violations.size());
+}
+
+int runMonoCheck(const ProcessorBenchmarkOptions& options)
+{
+    if(options.doublePrecision)
+        return runMonoCheckAt<double>(options);
+
+    return runMonoCheckAt<float>(options);
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmark.h
+    Created: 18 Oct 2026 7:02:51pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Drives ParametricEQAudioProcessor::processBlock the way a host would, with every band switched on
+// and white noise coming in, and times each block.  Every channel mode, sample rate and block size is
+// run with the parameters held still and with all the bands automated, and reported as the mean cost
+// per sample frame, the block time percentiles, and the worst block as a share of its real time budget,
+// along with the latency the processor reports.  In linear phase it also counts the late and missed
+// partitions of NonUniformConvolver, and returns the number of runs that missed any.
+struct ProcessorBenchmarkOptions
+{
+    bool doublePrecision {false};
+    bool editorActive {false};      // also feed the meters and the analyzer
+    bool csv {false};               // one line per run, for diffing between releases
+    int oversamplingOrder {0};      // 0 is the base path, 1 and 2 run the filters at 2x and 4x
+    bool linearPhase {false};       // run the FIR path instead of the IIR one
+    double secondsPerRun {5.0};
+};
+
+int runProcessorBenchmark(const ProcessorBenchmarkOptions& options);
+
+// Runs processBlock under RealtimeAudit in every channel mode, at every oversampling factor and in
+// linear phase, with automation, with the editor closed and open.  Prints every distinct allocation
+// or lock it caught with its stack trace, and returns the number of them, or -1 if the audit is not
+// compiled in.
+int runRealtimeAudit(const ProcessorBenchmarkOptions& options);
+
+// Runs a mono bus against the left of a stereo one with the same input and parameters, at every
+// oversampling factor, and prints the largest difference and what the mono path costs next to
+// stereo.  Returns the number of runs where the outputs weren't identical.
+int runMonoCheck(const ProcessorBenchmarkOptions& options);
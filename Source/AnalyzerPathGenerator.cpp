@@ -17,7 +17,13 @@ void AnalyzerPathGenerator::generatePath(const std::vector<float>& renderData,
                                          float negativeInfinity,
                                          float maxDb)
 {
-    juce::Path fftPath;
+    // built in its slot, reusing whatever storage the last path there had
+    auto* slot = pathFifo.claim();
+    if(slot == nullptr)
+        return;
+    
+    auto& fftPath = *slot;
+    fftPath.clear();
     
     auto startX = fftBounds.getX();
     auto endX  = startX + fftBounds.getWidth();
@@ -83,7 +89,7 @@ void AnalyzerPathGenerator::generatePath(const std::vector<float>& renderData,
             break;
     }
     
-    pathFifo.push(fftPath);
+    pathFifo.commit();
 }
 
 size_t AnalyzerPathGenerator::getNumPathsAvailable() const
@@ -93,5 +99,5 @@ size_t AnalyzerPathGenerator::getNumPathsAvailable() const
 
 bool AnalyzerPathGenerator::getPath(juce::Path& path)
 {
-    return pathFifo.pull(path);
+    return pathFifo.exchange(path);
 }
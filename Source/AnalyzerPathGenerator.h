@@ -10,7 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include "Fifo.h"
+#include "SpscRing.h"
 
 #define PATH_FIFO_DEPTH 100
 #define MIN_FREQ 20.f
@@ -29,8 +29,10 @@ struct AnalyzerPathGenerator
                       float maxDb = 12.f);
     
     size_t getNumPathsAvailable() const;
+    
+    // swaps path with the oldest one, whose storage the generator then reuses
     bool getPath(juce::Path& path);
     
 private:
-    Fifo<juce::Path, PATH_FIFO_DEPTH> pathFifo;
+    SpscRing<juce::Path, PATH_FIFO_DEPTH> pathFifo;
 };
@@ -74,10 +74,9 @@ inline const std::map<ProcessingModes, juce::String>& GetProcessingModes()
 }
 
 
-inline const juce::String getAnalyzerParamName(ParamNames name)
+inline const juce::String& getAnalyzerParamName(ParamNames name)
 {
-    auto const params = GetAnalyzerParams();
-    return params.at(name);
+    return GetAnalyzerParams().at(name);
 }
 
 inline FFTOrder getFFTOrder(float paramValue)
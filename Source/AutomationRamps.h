@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    AutomationRamps.h
+    Created: 19 Oct 2026 4:21:37am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <JuceHeader.h>
+#include "BandChangeMask.h"
+
+// How long each band's smoothers take to reach a new value.  A change on its own ramps over the whole
+// maximum, so a click on a control doesn't zip, but a band whose changes keep coming ramps over the time
+// since its last one, so automation reaches each value about when the next one arrives instead of a
+// fixed ramp later.
+//
+// JUCE sets automated parameters before processBlock without saying where in the block the host had
+// them, so the time between changes is counted in whole blocks.
+struct AutomationRamps
+{
+    void prepare(double newSampleRate, float newMaxRampSeconds)
+    {
+        sampleRate = newSampleRate;
+        maxRampSeconds = newMaxRampSeconds;
+        reset();
+    }
+
+    // every band's next change counts as one on its own
+    void reset()
+    {
+        time = 0;
+        lastChange.fill(std::numeric_limits<juce::int64>::min() / 2);
+        rampSeconds.fill(maxRampSeconds);
+    }
+
+    // once per block, before the bands that changed read their ramps
+    void update(BandChangeMask::Mask changed, int numSamples)
+    {
+        for(size_t band = 0; band < static_cast<size_t>(BandChangeMask::numBands); ++band)
+        {
+            if((changed & (BandChangeMask::Mask(1) << band)) == 0)
+                continue;
+
+            auto gapSeconds = static_cast<double>(time - lastChange[band]) / sampleRate;
+            rampSeconds[band] = static_cast<float>(juce::jmin(static_cast<double>(maxRampSeconds), gapSeconds));
+            lastChange[band] = time;
+        }
+
+        time += numSamples;
+    }
+
+    float getRampSeconds(Channel channel, ChainPosition chainPos) const
+    {
+        return rampSeconds[static_cast<size_t>(BandChangeMask::getIndex(channel, chainPos))];
+    }
+
+private:
+    double sampleRate {44100.0};
+    float maxRampSeconds {0.05f};
+
+    // in host samples
+    juce::int64 time {0};
+    std::array<juce::int64, BandChangeMask::numBands> lastChange;
+    std::array<float, BandChangeMask::numBands> rampSeconds;
+};
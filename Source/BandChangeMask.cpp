@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    BandChangeMask.cpp
+    Created: 18 Oct 2026 9:48:12pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "BandChangeMask.h"
+
+BandChangeMask::BandChangeMask(juce::AudioProcessorValueTreeState& apv) : apvts{apv}
+{
+    auto listener = bandListeners.begin();
+
+    for(auto channel : {Channel::Left, Channel::Right})
+    {
+        for(int position = 0; position < 8; ++position, ++listener)
+        {
+            auto chainPos = static_cast<ChainPosition>(position);
+            auto isCut = chainPos == ChainPosition::LowCut || chainPos == ChainPosition::HighCut;
+
+            listener->owner = this;
+            listener->bit = getBit(channel, chainPos);
+            listener->parameterIDs.add(createBypassParamString(channel, chainPos));
+            listener->parameterIDs.add(createFreqParamString(channel, chainPos));
+            listener->parameterIDs.add(createQParamString(channel, chainPos));
+            listener->parameterIDs.add(isCut ? createSlopeParamString(channel, chainPos) : createGainParamString(channel, chainPos));
+
+            for(const auto& parameterID : listener->parameterIDs)
+                apvts.addParameterListener(parameterID, &*listener);
+        }
+    }
+}
+
+BandChangeMask::~BandChangeMask()
+{
+    for(auto& listener : bandListeners)
+        for(const auto& parameterID : listener.parameterIDs)
+            apvts.removeParameterListener(parameterID, &listener);
+}
+
+void BandChangeMask::BandListener::parameterChanged(const juce::String& /*parameterID*/, float /*newValue*/)
+{
+    owner->changed.fetch_or(bit, std::memory_order_release);
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    BandChangeMask.h
+    Created: 18 Oct 2026 9:48:12pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <JuceHeader.h>
+#include "ParameterHelpers.h"
+
+// Which bands have had a parameter move since the audio thread last looked, one bit per channel and
+// chain position.  Each band has an apvts listener on its parameters that sets the band's bit from
+// whichever thread changed it.  The audio thread takes the whole mask once per block, so the bands
+// nobody touched skip their pre-loop update.
+struct BandChangeMask
+{
+    using Mask = uint32_t;
+
+    explicit BandChangeMask(juce::AudioProcessorValueTreeState& apvts);
+    ~BandChangeMask();
+
+    static constexpr int numBands {16};
+    static constexpr Mask allBands {(Mask(1) << numBands) - 1};
+
+    static constexpr int getIndex(Channel channel, ChainPosition chainPos)
+    {
+        return static_cast<int>(channel) * 8 + static_cast<int>(chainPos);
+    }
+
+    static constexpr Mask getBit(Channel channel, ChainPosition chainPos)
+    {
+        return Mask(1) << getIndex(channel, chainPos);
+    }
+
+    // the bands that changed since the last call, which are then cleared
+    Mask take()
+    {
+        return changed.exchange(0, std::memory_order_acq_rel);
+    }
+
+    // makes every band count as changed on the next take()
+    void markAll()
+    {
+        changed.fetch_or(allBands, std::memory_order_release);
+    }
+
+private:
+    // apvts listeners are called after the new value is stored, so whoever takes the bit reads it.
+    struct BandListener : juce::AudioProcessorValueTreeState::Listener
+    {
+        void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+        BandChangeMask* owner {nullptr};
+        Mask bit {0};
+        juce::StringArray parameterIDs;
+    };
+
+    juce::AudioProcessorValueTreeState& apvts;
+
+    // starts out all set, so the first block looks at everything
+    std::atomic<Mask> changed {allBands};
+
+    std::array<BandListener, numBands> bandListeners;
+
+    JUCE_DECLARE_NON_COPYABLE (BandChangeMask)
+};
@@ -0,0 +1,435 @@
+/*
+  ==============================================================================
+
+    BiquadCoefficients.cpp
+    Created: 18 Oct 2026 10:41:52am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "BiquadCoefficients.h"
+#include "FastMath.h"
+#include <complex>
+
+namespace
+{
+    using Constants = juce::MathConstants<double>;
+
+    // same lower limit juce uses for the shelf and peak designs
+    double getOmega(double sampleRate, double frequency)
+    {
+        return Constants::twoPi * juce::jmax(frequency, 2.0) / sampleRate;
+    }
+
+    // e^x
+    double exp(double x)
+    {
+        constexpr double log2OfE = 1.44269504088896340736;
+        return FastMath::exp2(x * log2OfE);
+    }
+
+    // A second order section's squared magnitude on the unit circle is B0 phi0 + B1 phi1 + B2 phi2 over
+    // A0 phi0 + A1 phi1 + A2 phi2, with B0 = (b0 + b1 + b2)^2, B1 = (b0 - b1 + b2)^2, B2 = -4 b0 b2 and the
+    // A terms alike.  At DC only phi0 is left and at Nyquist only phi1.
+    struct Phi
+    {
+        double phi0, phi1, phi2;
+    };
+
+    // phi1 = sin^2(omega / 2), straight from the sine so it stays exact at the lowest frequencies.
+    // omega is no more than pi, so half of it needs no range reduction.
+    Phi getPhi(double omega)
+    {
+        auto halfSin = FastMath::sinInRange(0.5 * omega);
+        auto phi1 = halfSin * halfSin;
+        auto phi0 = 1.0 - phi1;
+        return {phi0, phi1, 4.0 * phi0 * phi1};
+    }
+
+    // poleOmega and poleQuality describe the prototype's poles in radians per sample, which every caller
+    // has at or below omega0, the corner or centre frequency.  analogMagnitudeSquared takes the analog
+    // frequency relative to omega0.  Its magnitude at DC and its square at omega0, where the third match
+    // is made, come in closed form, which leaves one exp, one cos and one sin for the whole design.
+    //
+    // invert turns the result over, poles for zeros, which costs nothing extra since normalising
+    // either way takes the one division.
+    template <typename Magnitude>
+    BiquadCoefficients makeMatched(double omega0, double poleOmega, double poleQuality, double dcMagnitude,
+                                   double centreMagnitudeSquared, bool invert, Magnitude&& analogMagnitudeSquared)
+    {
+        // z = e^(sT) for the poles, under or over damped
+        auto zeta = 0.5 / poleQuality;
+        auto decay = exp(-zeta * poleOmega);
+        double a1;
+
+        if(zeta <= 1.0)
+        {
+            auto angle = juce::jmin(std::sqrt(1.0 - zeta * zeta) * poleOmega, Constants::pi);
+            a1 = -2.0 * decay * FastMath::cosInRange(angle);
+        }
+        else
+        {
+            auto growth = exp(std::sqrt(zeta * zeta - 1.0) * poleOmega);
+            a1 = -decay * (growth + 1.0 / growth);
+        }
+
+        auto a2 = decay * decay;
+
+        // (1 - p1)(1 - p2) and (1 + p1)(1 + p2), both positive for poles inside the unit circle
+        auto dcTerm = 1.0 + a1 + a2;
+        auto nyquistTerm = 1.0 - a1 + a2;
+
+        auto A0 = dcTerm * dcTerm;
+        auto A1 = nyquistTerm * nyquistTerm;
+        auto A2 = -4.0 * a2;
+
+        // The third match has to stay clear of Nyquist, where it would say nothing new.  None of this
+        // depends on the gain, so it's worked out alongside the poles.
+        constexpr double highestMatch = 0.95 * Constants::pi;
+        auto matchOmega = juce::jmin(omega0, highestMatch);
+        auto phi = getPhi(matchOmega);
+        auto phi2Inverse = 1.0 / phi.phi2;
+
+        auto matchMagnitude = omega0 < highestMatch ? centreMagnitudeSquared : analogMagnitudeSquared(highestMatch / omega0);
+        auto nyquistMagnitudeSquared = analogMagnitudeSquared(Constants::pi / omega0);
+
+        auto sqrtB0 = dcTerm * dcMagnitude;
+        auto sqrtB1 = nyquistTerm * std::sqrt(nyquistMagnitudeSquared);
+
+        auto B0 = sqrtB0 * sqrtB0;
+        auto B1 = A1 * nyquistMagnitudeSquared;
+        auto B2 = (matchMagnitude * (A0 * phi.phi0 + A1 * phi.phi1 + A2 * phi.phi2) - B0 * phi.phi0 - B1 * phi.phi1) * phi2Inverse;
+
+        auto W = 0.5 * (sqrtB0 + sqrtB1);
+        auto b0 = 0.5 * (W + std::sqrt(juce::jmax(0.0, W * W + B2)));
+        auto b1 = 0.5 * (sqrtB0 - sqrtB1);
+        auto b0Inverse = 1.0 / b0;
+
+        // b2 = -B2 / (4 b0)
+        auto b2 = -0.25 * B2 * b0Inverse;
+
+        BiquadCoefficients section;
+
+        if(invert)
+        {
+            section.b0 = b0Inverse;
+            section.b1 = a1 * b0Inverse;
+            section.b2 = a2 * b0Inverse;
+            section.a1 = b1 * b0Inverse;
+            section.a2 = b2 * b0Inverse;
+        }
+        else
+        {
+            section.b0 = b0;
+            section.b1 = b1;
+            section.b2 = b2;
+            section.a1 = a1;
+            section.a2 = a2;
+        }
+
+        return section;
+    }
+
+    // These prototypes cut with exactly the inverse of the same boost.  Whichever way round has its poles
+    // above the corner (a low shelf's cut, a high shelf's boost) can push them past Nyquist, where matching
+    // goes wrong.  So that one is designed the other way round and turned over, which the minimum phase
+    // zeros of the matched design allow.  design takes the gain to design for and whether to turn it over.
+    template <typename Design>
+    BiquadCoefficients makeMatchedInvertible(double gainFactor, bool boostHasLowPoles, Design&& design)
+    {
+        auto invert = (gainFactor >= 1.0) != boostHasLowPoles;
+        return design(invert ? 1.0 / gainFactor : gainFactor, invert);
+    }
+}
+
+double BiquadCoefficients::getMagnitudeForFrequency(double frequency, double sampleRate) const
+{
+    jassert(sampleRate > 0);
+    jassert(frequency >= 0 && frequency <= sampleRate * 0.5);
+
+    const std::complex<double> j (0, 1);
+    auto jw = std::exp(-Constants::twoPi * frequency * j / sampleRate);
+
+    auto numerator = b0 + (b1 + b2 * jw) * jw;
+    auto denominator = 1.0 + (a1 + a2 * jw) * jw;
+
+    return std::abs(numerator / denominator);
+}
+
+BiquadCoefficients BiquadCoefficients::fromUnnormalised(double b0, double b1, double b2, double a0, double a1, double a2)
+{
+    jassert(a0 != 0);
+    auto a0Inv = 1.0 / a0;
+
+    BiquadCoefficients section;
+    section.b0 = b0 * a0Inv;
+    section.b1 = b1 * a0Inv;
+    section.b2 = b2 * a0Inv;
+    section.a1 = a1 * a0Inv;
+    section.a2 = a2 * a0Inv;
+    return section;
+}
+
+BiquadCoefficients BiquadCoefficients::makeFirstOrderLowPass(double sampleRate, double frequency)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+
+    return makePrewarpedFirstOrderLowPass(FastMath::tan(Constants::pi * frequency / sampleRate));
+}
+
+BiquadCoefficients BiquadCoefficients::makeFirstOrderHighPass(double sampleRate, double frequency)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+
+    return makePrewarpedFirstOrderHighPass(FastMath::tan(Constants::pi * frequency / sampleRate));
+}
+
+BiquadCoefficients BiquadCoefficients::makeFirstOrderAllPass(double sampleRate, double frequency)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+
+    auto n = FastMath::tan(Constants::pi * frequency / sampleRate);
+    return fromUnnormalised(n - 1.0, n + 1.0, 0.0, n + 1.0, n - 1.0, 0.0);
+}
+
+BiquadCoefficients BiquadCoefficients::makeLowPass(double sampleRate, double frequency, double quality)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert(quality > 0.0);
+
+    return makePrewarpedLowPass(FastMath::tan(Constants::pi * frequency / sampleRate), quality);
+}
+
+BiquadCoefficients BiquadCoefficients::makeHighPass(double sampleRate, double frequency, double quality)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert(quality > 0.0);
+
+    return makePrewarpedHighPass(FastMath::tan(Constants::pi * frequency / sampleRate), quality);
+}
+
+BiquadCoefficients BiquadCoefficients::makeBandPass(double sampleRate, double frequency, double quality)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert(quality > 0.0);
+
+    auto n = 1.0 / FastMath::tan(Constants::pi * frequency / sampleRate);
+    auto nSquared = n * n;
+    auto invQ = 1.0 / quality;
+
+    return fromUnnormalised(n * invQ, 0.0, -n * invQ,
+                            1.0 + invQ * n + nSquared, 2.0 * (1.0 - nSquared), 1.0 - invQ * n + nSquared);
+}
+
+BiquadCoefficients BiquadCoefficients::makeNotch(double sampleRate, double frequency, double quality)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert(quality > 0.0);
+
+    auto n = 1.0 / FastMath::tan(Constants::pi * frequency / sampleRate);
+    auto nSquared = n * n;
+    auto invQ = 1.0 / quality;
+
+    return fromUnnormalised(1.0 + nSquared, 2.0 * (1.0 - nSquared), 1.0 + nSquared,
+                            1.0 + invQ * n + nSquared, 2.0 * (1.0 - nSquared), 1.0 - invQ * n + nSquared);
+}
+
+BiquadCoefficients BiquadCoefficients::makeAllPass(double sampleRate, double frequency, double quality)
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert(quality > 0.0);
+
+    auto n = 1.0 / FastMath::tan(Constants::pi * frequency / sampleRate);
+    auto nSquared = n * n;
+    auto invQ = 1.0 / quality;
+
+    return fromUnnormalised(1.0 - invQ * n + nSquared, 2.0 * (1.0 - nSquared), 1.0 + invQ * n + nSquared,
+                            1.0 + invQ * n + nSquared, 2.0 * (1.0 - nSquared), 1.0 - invQ * n + nSquared);
+}
+
+BiquadCoefficients BiquadCoefficients::makeLowShelf(double sampleRate, double frequency, double quality, double gainFactor)
+{
+    jassert(sampleRate > 0.0);
+    jassert(quality > 0.0);
+
+    auto A = std::sqrt(juce::jmax(0.0, gainFactor));
+    auto aminus1 = A - 1.0;
+    auto aplus1 = A + 1.0;
+    auto omega = getOmega(sampleRate, frequency);
+    double sino, coso;
+    FastMath::sinCos(omega, sino, coso);
+    auto beta = sino * std::sqrt(A) / quality;
+    auto aminus1TimesCoso = aminus1 * coso;
+
+    return fromUnnormalised(A * (aplus1 - aminus1TimesCoso + beta),
+                            A * 2.0 * (aminus1 - aplus1 * coso),
+                            A * (aplus1 - aminus1TimesCoso - beta),
+                            aplus1 + aminus1TimesCoso + beta,
+                            -2.0 * (aminus1 + aplus1 * coso),
+                            aplus1 + aminus1TimesCoso - beta);
+}
+
+BiquadCoefficients BiquadCoefficients::makeHighShelf(double sampleRate, double frequency, double quality, double gainFactor)
+{
+    jassert(sampleRate > 0.0);
+    jassert(quality > 0.0);
+
+    auto A = std::sqrt(juce::jmax(0.0, gainFactor));
+    auto aminus1 = A - 1.0;
+    auto aplus1 = A + 1.0;
+    auto omega = getOmega(sampleRate, frequency);
+    double sino, coso;
+    FastMath::sinCos(omega, sino, coso);
+    auto beta = sino * std::sqrt(A) / quality;
+    auto aminus1TimesCoso = aminus1 * coso;
+
+    return fromUnnormalised(A * (aplus1 + aminus1TimesCoso + beta),
+                            A * -2.0 * (aminus1 + aplus1 * coso),
+                            A * (aplus1 + aminus1TimesCoso - beta),
+                            aplus1 - aminus1TimesCoso + beta,
+                            2.0 * (aminus1 - aplus1 * coso),
+                            aplus1 - aminus1TimesCoso - beta);
+}
+
+BiquadCoefficients BiquadCoefficients::makePeakFilter(double sampleRate, double frequency, double quality, double gainFactor)
+{
+    jassert(sampleRate > 0.0);
+    jassert(quality > 0.0);
+
+    auto A = juce::jmax(0.0, std::sqrt(gainFactor));
+    auto omega = getOmega(sampleRate, frequency);
+    double sino, coso;
+    FastMath::sinCos(omega, sino, coso);
+    auto alpha = sino / (quality * 2.0);
+    auto c2 = -2.0 * coso;
+    auto alphaTimesA = alpha * A;
+    auto alphaOverA = alpha / A;
+
+    return fromUnnormalised(1.0 + alphaTimesA, c2, 1.0 - alphaTimesA,
+                            1.0 + alphaOverA, c2, 1.0 - alphaOverA);
+}
+
+BiquadCoefficients BiquadCoefficients::makePrewarpedFirstOrderLowPass(double k)
+{
+    jassert(k > 0.0);
+
+    return fromUnnormalised(k, k, 0.0, k + 1.0, k - 1.0, 0.0);
+}
+
+BiquadCoefficients BiquadCoefficients::makePrewarpedFirstOrderHighPass(double k)
+{
+    jassert(k > 0.0);
+
+    return fromUnnormalised(1.0, -1.0, 0.0, k + 1.0, k - 1.0, 0.0);
+}
+
+BiquadCoefficients BiquadCoefficients::makePrewarpedLowPass(double k, double quality)
+{
+    jassert(k > 0.0);
+    jassert(quality > 0.0);
+
+    auto n = 1.0 / k;
+    auto nSquared = n * n;
+    auto invQ = 1.0 / quality;
+
+    return fromUnnormalised(1.0, 2.0, 1.0,
+                            1.0 + invQ * n + nSquared, 2.0 * (1.0 - nSquared), 1.0 - invQ * n + nSquared);
+}
+
+BiquadCoefficients BiquadCoefficients::makePrewarpedHighPass(double k, double quality)
+{
+    jassert(k > 0.0);
+    jassert(quality > 0.0);
+
+    auto n = k;
+    auto nSquared = n * n;
+    auto invQ = 1.0 / quality;
+
+    return fromUnnormalised(1.0, -2.0, 1.0,
+                            1.0 + invQ * n + nSquared, 2.0 * (nSquared - 1.0), 1.0 - invQ * n + nSquared);
+}
+
+// The prototypes are RBJ's, with A the square root of the gain:
+//   low shelf   A (s^2 + sqrt(A)/Q s + A) / (A s^2 + sqrt(A)/Q s + 1)
+//   high shelf  A (A s^2 + sqrt(A)/Q s + 1) / (s^2 + sqrt(A)/Q s + A)
+//   peak        (s^2 + A/Q s + 1) / (s^2 + 1/(A Q) s + 1)
+BiquadCoefficients BiquadCoefficients::makeMatchedLowShelf(double sampleRate, double frequency, double quality, double gainFactor)
+{
+    jassert(sampleRate > 0.0);
+    jassert(quality > 0.0);
+    jassert(gainFactor > 0.0);
+
+    auto omega0 = getOmega(sampleRate, frequency);
+
+    return makeMatchedInvertible(gainFactor, true, [omega0, quality](double gain, bool invert)
+    {
+        auto A = std::sqrt(gain);
+        auto damping = A / (quality * quality);
+
+        // the gain, A^2, at DC and A at the corner
+        return makeMatched(omega0, omega0 / std::sqrt(A), quality, gain, gain, invert, [A, damping](double w)
+        {
+            auto w2 = w * w;
+            auto numerator = (A - w2) * (A - w2) + w2 * damping;
+            auto denominator = (1.0 - A * w2) * (1.0 - A * w2) + w2 * damping;
+            return A * A * numerator / denominator;
+        });
+    });
+}
+
+BiquadCoefficients BiquadCoefficients::makeMatchedHighShelf(double sampleRate, double frequency, double quality, double gainFactor)
+{
+    jassert(sampleRate > 0.0);
+    jassert(quality > 0.0);
+    jassert(gainFactor > 0.0);
+
+    auto omega0 = getOmega(sampleRate, frequency);
+
+    return makeMatchedInvertible(gainFactor, false, [omega0, quality](double gain, bool invert)
+    {
+        auto A = std::sqrt(gain);
+        auto damping = A / (quality * quality);
+
+        // 1 at DC and A at the corner
+        return makeMatched(omega0, omega0 * std::sqrt(A), quality, 1.0, gain, invert, [A, damping](double w)
+        {
+            auto w2 = w * w;
+            auto numerator = (1.0 - A * w2) * (1.0 - A * w2) + w2 * damping;
+            auto denominator = (A - w2) * (A - w2) + w2 * damping;
+            return A * A * numerator / denominator;
+        });
+    });
+}
+
+BiquadCoefficients BiquadCoefficients::makeMatchedPeakFilter(double sampleRate, double frequency, double quality, double gainFactor)
+{
+    jassert(sampleRate > 0.0);
+    jassert(quality > 0.0);
+    jassert(gainFactor > 0.0);
+
+    auto omega0 = getOmega(sampleRate, frequency);
+
+    return makeMatchedInvertible(gainFactor, true, [omega0, quality](double gain, bool invert)
+    {
+        auto A = std::sqrt(gain);
+        auto zeroBandwidth = A / quality;
+        auto poleBandwidth = 1.0 / (A * quality);
+
+        // 1 at DC and the gain, A^2, at the centre
+        return makeMatched(omega0, omega0, A * quality, 1.0, gain * gain, invert, [zeroBandwidth, poleBandwidth](double w)
+        {
+            auto w2 = w * w;
+            auto resonance = (1.0 - w2) * (1.0 - w2);
+            return (resonance + w2 * zeroBandwidth * zeroBandwidth) / (resonance + w2 * poleBandwidth * poleBandwidth);
+        });
+    });
+}
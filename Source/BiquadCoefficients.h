@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    BiquadCoefficients.h
+    Created: 18 Oct 2026 9:02:11am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <JuceHeader.h>
+
+// One normalised (a0 == 1) second order section, stored in the order the
+// transposed direct form II kernel consumes them.  First order sections leave b2 and a2 at zero.
+// Kept in double so the double precision engine gets the full design, the float engine rounds on the way in.
+//
+// The factories follow juce::dsp::IIR::Coefficients, but return plain values so that
+// coefficients can be made and handed between threads without touching the heap.
+struct BiquadCoefficients
+{
+    double b0 {1.0}, b1 {0.0}, b2 {0.0}, a1 {0.0}, a2 {0.0};
+
+    bool isIdentity() const
+    {
+        return b0 == 1.0 && b1 == 0.0 && b2 == 0.0 && a1 == 0.0 && a2 == 0.0;
+    }
+
+    double getMagnitudeForFrequency(double frequency, double sampleRate) const;
+
+    static BiquadCoefficients makeFirstOrderLowPass(double sampleRate, double frequency);
+    static BiquadCoefficients makeFirstOrderHighPass(double sampleRate, double frequency);
+    static BiquadCoefficients makeFirstOrderAllPass(double sampleRate, double frequency);
+    static BiquadCoefficients makeLowPass(double sampleRate, double frequency, double quality);
+    static BiquadCoefficients makeHighPass(double sampleRate, double frequency, double quality);
+    static BiquadCoefficients makeBandPass(double sampleRate, double frequency, double quality);
+    static BiquadCoefficients makeNotch(double sampleRate, double frequency, double quality);
+    static BiquadCoefficients makeAllPass(double sampleRate, double frequency, double quality);
+    static BiquadCoefficients makeLowShelf(double sampleRate, double frequency, double quality, double gainFactor);
+    static BiquadCoefficients makeHighShelf(double sampleRate, double frequency, double quality, double gainFactor);
+    static BiquadCoefficients makePeakFilter(double sampleRate, double frequency, double quality, double gainFactor);
+
+    // The same shelves and peak without the bilinear transform's cramping near Nyquist, after Vicanek,
+    // "Matched Second Order Digital Filters".  The poles are the analog prototype's mapped exactly and
+    // the zeros are solved so the magnitude matches the prototype at DC, at the corner or centre and at
+    // Nyquist.  No latency and no oversampling, and like the designs above no libm calls.
+    static BiquadCoefficients makeMatchedLowShelf(double sampleRate, double frequency, double quality, double gainFactor);
+    static BiquadCoefficients makeMatchedHighShelf(double sampleRate, double frequency, double quality, double gainFactor);
+    static BiquadCoefficients makeMatchedPeakFilter(double sampleRate, double frequency, double quality, double gainFactor);
+
+    // k is the prewarped frequency, tan(pi * frequency / sampleRate), for callers that already have it.
+    static BiquadCoefficients makePrewarpedFirstOrderLowPass(double k);
+    static BiquadCoefficients makePrewarpedFirstOrderHighPass(double k);
+    static BiquadCoefficients makePrewarpedLowPass(double k, double quality);
+    static BiquadCoefficients makePrewarpedHighPass(double k, double quality);
+
+    // takes the un-normalised b0, b1, b2, a0, a1, a2
+    static BiquadCoefficients fromUnnormalised(double b0, double b1, double b2, double a0, double a1, double a2);
+};
+
+inline bool operator==(const BiquadCoefficients& lhs, const BiquadCoefficients& rhs)
+{
+    return (lhs.b0 == rhs.b0 && lhs.b1 == rhs.b1 && lhs.b2 == rhs.b2 && lhs.a1 == rhs.a1 && lhs.a2 == rhs.a2);
+}
+
+inline bool operator!=(const BiquadCoefficients& lhs, const BiquadCoefficients& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// A fixed size cascade of sections, small enough to pass around by value.
+// Parametric bands use one section, the cut filters up to four.
+template <size_t MaxSections>
+struct CascadeCoefficients
+{
+    static constexpr size_t maxSections = MaxSections;
+
+    std::array<BiquadCoefficients, MaxSections> sections;
+    size_t numSections {0};
+
+    void add(const BiquadCoefficients& section)
+    {
+        jassert(numSections < MaxSections);
+        sections[numSections++] = section;
+    }
+
+    double getMagnitudeForFrequency(double frequency, double sampleRate) const
+    {
+        double magnitude {1.0};
+
+        for(size_t i = 0; i < numSections; ++i)
+            magnitude *= sections[i].getMagnitudeForFrequency(frequency, sampleRate);
+
+        return magnitude;
+    }
+};
+
+using ParametricCoefficients = CascadeCoefficients<1>;
+using CutCoefficients = CascadeCoefficients<4>;
@@ -0,0 +1,338 @@
+/*
+  ==============================================================================
+
+    BiquadEngine.h
+    Created: 18 Oct 2026 9:14:37am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <JuceHeader.h>
+#include "BiquadCoefficients.h"
+#include "FastMath.h"
+
+// Runs a cascade of NumSections second order sections over several channels in a single pass.
+// Every channel is one lane of a juce::dsp::SIMDRegister (4 float or 2 double lanes on SSE and NEON)
+// with its own coefficients and state, so left/right or mid/side can be filtered differently and
+// still share the same instructions.  The block is interleaved into lane order once, every section then runs
+// over the whole block with its state held in registers, and the result is written back.
+//
+// More channels than lanes, a surround or ambisonic bus, take a group of sections per numLanes
+// channels, so the cost goes up with the number of registers the channels fill rather than with
+// the number of channels.
+//
+// New coefficients are targets: the next call to process() moves every changed section linearly
+// from its current coefficients to the target across the block, one step per sample, so updates
+// never need to land on a sub-block boundary.
+//
+// Sections that are identity in every lane (bypassed bands, 0 dB peaks and shelves, the unused
+// sections of a low order cut) are left out of the block entirely once their state has run out,
+// which an identity section does within two samples.
+template <typename SampleType, size_t NumSections>
+class BiquadEngine
+{
+public:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Register::SIMDNumElements;
+
+    // Lanes that have never been given coefficients are identity.
+    void prepare(int maximumBlockSize, int maximumNumChannels = static_cast<int>(numLanes))
+    {
+        interleaved.assign(static_cast<size_t>(juce::jmax(1, maximumBlockSize)), Register::expand(0));
+        groups.resize((static_cast<size_t>(juce::jmax(1, maximumNumChannels)) + numLanes - 1) / numLanes);
+        reset();
+    }
+
+    size_t getNumChannels() const   { return groups.size() * numLanes; }
+
+    // clears the filter state and jumps straight to the target coefficients.
+    void reset()
+    {
+        for(auto& sections : groups)
+        {
+            for(auto& section : sections)
+            {
+                section.current = section.target;
+                section.targetChanged = false;
+                section.currentIsIdentity = section.current.isIdentity();
+                section.tailLength = section.current.getTailLength();
+                section.s1 = Register::expand(0);
+                section.s2 = Register::expand(0);
+            }
+        }
+    }
+
+    // the largest value left in any section's state, 0 once everything has rung out.
+    SampleType getStateMagnitude() const
+    {
+        auto magnitude = Register::expand(0);
+
+        for(const auto& sections : groups)
+            for(const auto& section : sections)
+                magnitude = Register::max(magnitude, Register::max(Register::abs(section.s1), Register::abs(section.s2)));
+
+        SampleType result = 0;
+
+        for(size_t lane = 0; lane < numLanes; ++lane)
+            result = juce::jmax(result, magnitude.get(lane));
+
+        return result;
+    }
+
+    // How many samples an impulse takes to decay by tailDecayDb through the whole cascade, worked out
+    // from the pole radii of the current coefficients.  Within a lane the sections' tails add up,
+    // the longest lane wins.
+    double getTailLengthSamples() const
+    {
+        double longest = 0.0;
+
+        for(const auto& sections : groups)
+        {
+            for(size_t lane = 0; lane < numLanes; ++lane)
+            {
+                double tail = 0.0;
+
+                for(const auto& section : sections)
+                    tail += section.tailLength[lane];
+
+                longest = juce::jmax(longest, tail);
+            }
+        }
+
+        return longest;
+    }
+
+    static constexpr double tailDecayDb {-160.0};
+
+    void setCoefficients(size_t sectionIndex, size_t channel, const BiquadCoefficients& coefficients)
+    {
+        jassert(sectionIndex < NumSections && channel < getNumChannels());
+
+        auto lane = channel % numLanes;
+        auto& section = groups[channel / numLanes][sectionIndex];
+        auto& target = section.target;
+        target.b0.set(lane, static_cast<SampleType>(coefficients.b0));
+        target.b1.set(lane, static_cast<SampleType>(coefficients.b1));
+        target.b2.set(lane, static_cast<SampleType>(coefficients.b2));
+        target.a1.set(lane, static_cast<SampleType>(coefficients.a1));
+        target.a2.set(lane, static_cast<SampleType>(coefficients.a2));
+
+        const auto& current = section.current;
+        section.targetChanged = section.targetChanged ||
+                                current.b0.get(lane) != target.b0.get(lane) ||
+                                current.b1.get(lane) != target.b1.get(lane) ||
+                                current.b2.get(lane) != target.b2.get(lane) ||
+                                current.a1.get(lane) != target.a1.get(lane) ||
+                                current.a2.get(lane) != target.a2.get(lane);
+    }
+
+    // channels[i] + startSample is filtered in place for i < numChannels.
+    void process(SampleType* const* channels, size_t numChannels, int startSample, int numSamples)
+    {
+        jassert(numChannels <= getNumChannels());
+        jassert(! interleaved.empty()); // call prepare() first
+
+        if(numSamples <= 0)
+            return;
+
+        for(size_t first = 0; first < numChannels; first += numLanes)
+            processGroup(groups[first / numLanes], channels + first, std::min(numLanes, numChannels - first), startSample, numSamples);
+    }
+
+private:
+    struct Section;
+    using Sections = std::array<Section, NumSections>;
+
+    void processGroup(Sections& sections, SampleType* const* channels, size_t numChannels, int startSample, int numSamples)
+    {
+        auto stepScale = Register::expand(static_cast<SampleType>(1) / static_cast<SampleType>(numSamples));
+
+        std::array<Section*, NumSections> activeSections;
+        size_t numActive = 0;
+
+        for(auto& section : sections)
+        {
+            if(section.targetChanged)
+            {
+                section.step.b0 = (section.target.b0 - section.current.b0) * stepScale;
+                section.step.b1 = (section.target.b1 - section.current.b1) * stepScale;
+                section.step.b2 = (section.target.b2 - section.current.b2) * stepScale;
+                section.step.a1 = (section.target.a1 - section.current.a1) * stepScale;
+                section.step.a2 = (section.target.a2 - section.current.a2) * stepScale;
+            }
+
+            // a section ramping to or from identity still has to run, and so does one that
+            // just got there until the rest of its old output has come out.
+            if(section.targetChanged || ! section.currentIsIdentity || ! section.hasClearState())
+                activeSections[numActive++] = &section;
+        }
+
+        if(numActive == 0)
+            return;
+
+        auto capacity = static_cast<int>(interleaved.size());
+        int offset = 0;
+
+        while(offset < numSamples)
+        {
+            auto blockSize = std::min(numSamples - offset, capacity);
+
+            interleave(channels, numChannels, startSample + offset, blockSize);
+
+            for(size_t i = 0; i < numActive; ++i)
+            {
+                auto& section = *activeSections[i];
+
+                if(section.targetChanged)
+                    processSection<true>(section, interleaved.data(), blockSize);
+                else
+                    processSection<false>(section, interleaved.data(), blockSize);
+            }
+
+            deinterleave(channels, numChannels, startSample + offset, blockSize);
+
+            offset += blockSize;
+        }
+
+        // land exactly on the target rather than on the accumulated steps.
+        for(auto& section : sections)
+        {
+            if(section.targetChanged)
+            {
+                section.current = section.target;
+                section.targetChanged = false;
+                section.currentIsIdentity = section.current.isIdentity();
+                section.tailLength = section.current.getTailLength();
+            }
+        }
+    }
+
+    struct SectionCoefficients
+    {
+        Register b0 {Register::expand(1)}, b1 {Register::expand(0)}, b2 {Register::expand(0)};
+        Register a1 {Register::expand(0)}, a2 {Register::expand(0)};
+
+        bool isIdentity() const
+        {
+            return b0 == 1 && b1 == 0 && b2 == 0 && a1 == 0 && a2 == 0;
+        }
+
+        // tail of each lane, in samples
+        std::array<double, numLanes> getTailLength() const
+        {
+            std::array<double, numLanes> tails {};
+
+            for(size_t lane = 0; lane < numLanes; ++lane)
+            {
+                double p1 = a1.get(lane), p2 = a2.get(lane);
+                double discriminant = p1 * p1 - 4.0 * p2;
+
+                // complex poles sit at radius sqrt(a2), real ones at the larger root.
+                double radius = discriminant < 0.0 ? std::sqrt(p2)
+                                                   : 0.5 * (std::abs(p1) + std::sqrt(discriminant));
+
+                if(radius <= 0.0)
+                    tails[lane] = 0.0;
+                else if(radius >= 1.0)
+                    tails[lane] = std::numeric_limits<double>::infinity();   // never dies away
+                else
+                    tails[lane] = (tailDecayDb / 20.0) * FastMath::log2(10.0) / FastMath::log2(radius);
+            }
+
+            return tails;
+        }
+    };
+
+    struct Section
+    {
+        SectionCoefficients current, target, step;
+        Register s1 {Register::expand(0)}, s2 {Register::expand(0)};
+        bool targetChanged {false};
+        bool currentIsIdentity {true};
+        std::array<double, numLanes> tailLength {};
+
+        bool hasClearState() const
+        {
+            return s1 == 0 && s2 == 0;
+        }
+    };
+
+    // transposed direct form II, one lane per channel.
+    template <bool Ramp>
+    static void processSection(Section& section, Register* data, int numSamples)
+    {
+        auto b0 = section.current.b0, b1 = section.current.b1, b2 = section.current.b2;
+        auto a1 = section.current.a1, a2 = section.current.a2;
+        auto s1 = section.s1, s2 = section.s2;
+
+        for(int i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+            auto y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            data[i] = y;
+
+            if constexpr (Ramp)
+            {
+                b0 += section.step.b0;
+                b1 += section.step.b1;
+                b2 += section.step.b2;
+                a1 += section.step.a1;
+                a2 += section.step.a2;
+            }
+        }
+
+        if constexpr (Ramp)
+        {
+            section.current.b0 = b0;
+            section.current.b1 = b1;
+            section.current.b2 = b2;
+            section.current.a1 = a1;
+            section.current.a2 = a2;
+        }
+
+        section.s1 = s1;
+        section.s2 = s2;
+    }
+
+    void interleave(SampleType* const* channels, size_t numChannels, int startSample, int numSamples)
+    {
+        auto* dest = reinterpret_cast<SampleType*>(interleaved.data());
+
+        for(size_t lane = 0; lane < numLanes; ++lane)
+        {
+            if(lane < numChannels)
+            {
+                auto* src = channels[lane] + startSample;
+                for(int i = 0; i < numSamples; ++i)
+                    dest[static_cast<size_t>(i) * numLanes + lane] = src[i];
+            }
+            else
+            {
+                for(int i = 0; i < numSamples; ++i)
+                    dest[static_cast<size_t>(i) * numLanes + lane] = 0;
+            }
+        }
+    }
+
+    void deinterleave(SampleType* const* channels, size_t numChannels, int startSample, int numSamples)
+    {
+        auto* src = reinterpret_cast<const SampleType*>(interleaved.data());
+
+        for(size_t lane = 0; lane < numChannels; ++lane)
+        {
+            auto* dest = channels[lane] + startSample;
+            for(int i = 0; i < numSamples; ++i)
+                dest[i] = src[static_cast<size_t>(i) * numLanes + lane];
+        }
+    }
+
+    std::vector<Sections> groups;
+    std::vector<Register> interleaved;
+};
@@ -13,18 +13,33 @@
 #include <JuceHeader.h>
 #include "FilterInfo.h"
 #include "FilterLink.h"
+#include "ParameterTable.h"
  
 
 namespace ChainHelpers
 {
  
-using Filter = juce::dsp::IIR::Filter<float>;
-using CutChain = juce::dsp::ProcessorChain<Filter,Filter,Filter,Filter>;
-using CutFilter = FilterLink<CutChain, CutCoeffArray, HighCutLowCutParameters, CoefficientsMaker>;
-using ParametricFilter = FilterLink<Filter, FilterCoeffPtr, FilterParameters, CoefficientsMaker>;
+using CutFilter = FilterLink<HighCutLowCutParameters, CoefficientsMaker>;
+using ParametricFilter = FilterLink<FilterParameters, CoefficientsMaker>;
 
 constexpr size_t numberOfBands{8};
 
+// The filter engine sees the chain flattened into second order sections:
+// LowCut 0-3, LowShelf 4, PeakFilter1-4 5-8, HighShelf 9, HighCut 10-13.
+constexpr size_t sectionsPerCutFilter{CutCoefficients::maxSections};
+constexpr size_t numberOfSections{2 * sectionsPerCutFilter + numberOfBands - 2};
+
+constexpr size_t getFirstSection(ChainPosition chainPos)
+{
+    if(chainPos == ChainPosition::LowCut)
+        return 0;
+    
+    if(chainPos == ChainPosition::HighCut)
+        return numberOfSections - sectionsPerCutFilter;
+    
+    return sectionsPerCutFilter + static_cast<size_t>(chainPos) - 1;
+}
+
 using MonoFilterChain = juce::dsp::ProcessorChain<CutFilter,
                                             ParametricFilter,
                                             ParametricFilter,
@@ -34,13 +49,16 @@ using MonoFilterChain = juce::dsp::ProcessorChain<CutFilter,
                                             ParametricFilter,
                                             CutFilter>;
 
-inline FilterParameters getParametericFilterParams(const ChainPosition chainPos, Channel channel, double sampleRate, juce::AudioProcessorValueTreeState& apvts)
+inline FilterParameters getParametericFilterParams(const ChainPosition chainPos, Channel channel, double sampleRate, const ParameterTable& parameters)
 {
     using namespace FilterInfo;
     
-    float frequency = apvts.getRawParameterValue(createFreqParamString(channel, chainPos))->load();
-    float quality  = apvts.getRawParameterValue(createQParamString(channel, chainPos))->load();
-    bool bypassed = apvts.getRawParameterValue(createBypassParamString(channel, chainPos))->load() > 0.5f;
+    using Field = ParameterTable::Field;
+    float frequency = parameters.get(channel, chainPos, Field::Frequency);
+    float quality  = parameters.get(channel, chainPos, Field::Quality);
+    bool bypassed = parameters.get(channel, chainPos, Field::Bypass) > 0.5f;
+    
+    bool matched = parameters.getFilterDesign() > 0.5f;
     
     FilterParameters parametricParams;
     
@@ -48,13 +66,13 @@ inline FilterParameters getParametericFilterParams(const ChainPosition chainPos,
     switch(chainPos)
     {
         case ChainPosition::LowShelf:
-            parametricParams.filterType =  FilterType::LowShelf;
+            parametricParams.filterType = matched ? FilterType::MatchedLowShelf : FilterType::LowShelf;
             break;
         case ChainPosition::HighShelf:
-            parametricParams.filterType = FilterType::HighShelf;
+            parametricParams.filterType = matched ? FilterType::MatchedHighShelf : FilterType::HighShelf;
             break;
         default:
-            parametricParams.filterType = FilterType::PeakFilter;
+            parametricParams.filterType = matched ? FilterType::MatchedPeakFilter : FilterType::PeakFilter;
     }
         
     
@@ -62,20 +80,21 @@ inline FilterParameters getParametericFilterParams(const ChainPosition chainPos,
     parametricParams.sampleRate = sampleRate;
     parametricParams.quality = quality;
     parametricParams.bypassed = bypassed;
-    parametricParams.gain = Decibel <float> (apvts.getRawParameterValue(createGainParamString(channel, chainPos))-> load());
+    parametricParams.gain = Decibel <float> (parameters.get(channel, chainPos, Field::GainOrSlope));
     
     return parametricParams;
 
 }
 
-inline HighCutLowCutParameters getCutFilterParams(const ChainPosition chainPos, Channel channel, double sampleRate, juce::AudioProcessorValueTreeState& apvts)
+inline HighCutLowCutParameters getCutFilterParams(const ChainPosition chainPos, Channel channel, double sampleRate, const ParameterTable& parameters)
 {
     using namespace FilterInfo;
-    float frequency = apvts.getRawParameterValue(createFreqParamString(channel, chainPos))->load();
-    float quality  = apvts.getRawParameterValue(createQParamString(channel, chainPos))->load();
-    bool bypassed = apvts.getRawParameterValue(createBypassParamString(channel, chainPos))->load() > 0.5f;
+    using Field = ParameterTable::Field;
+    float frequency = parameters.get(channel, chainPos, Field::Frequency);
+    float quality  = parameters.get(channel, chainPos, Field::Quality);
+    bool bypassed = parameters.get(channel, chainPos, Field::Bypass) > 0.5f;
     
-    Slope slope = static_cast<Slope> (apvts.getRawParameterValue(createSlopeParamString(channel, chainPos))->load());
+    Slope slope = static_cast<Slope> (parameters.get(channel, chainPos, Field::GainOrSlope));
     
     HighCutLowCutParameters cutParams;
         
@@ -91,45 +110,62 @@ inline HighCutLowCutParameters getCutFilterParams(const ChainPosition chainPos,
  
 
 template <typename ParamType>
-ParamType getFilterParams(ChainPosition chainpos, Channel channel, double sampleRate, juce::AudioProcessorValueTreeState& apvts)
+ParamType getFilterParams(ChainPosition chainpos, Channel channel, double sampleRate, const ParameterTable& parameters)
 {
     jassert(false); // If you end up calling the base template then something went wrong.
     return ParamType();
 }
 
 template <>
-inline HighCutLowCutParameters getFilterParams<HighCutLowCutParameters>(ChainPosition chainpos, Channel channel, double sampleRate, juce::AudioProcessorValueTreeState& apvts)
+inline HighCutLowCutParameters getFilterParams<HighCutLowCutParameters>(ChainPosition chainpos, Channel channel, double sampleRate, const ParameterTable& parameters)
 {
-    return getCutFilterParams(chainpos, channel, sampleRate, apvts);
+    return getCutFilterParams(chainpos, channel, sampleRate, parameters);
 }
 
 template <>
-inline FilterParameters getFilterParams<FilterParameters>(ChainPosition chainpos, Channel channel, double sampleRate, juce::AudioProcessorValueTreeState& apvts)
+inline FilterParameters getFilterParams<FilterParameters>(ChainPosition chainpos, Channel channel, double sampleRate, const ParameterTable& parameters)
 {
-    return getParametericFilterParams(chainpos, channel, sampleRate, apvts);
+    return getParametericFilterParams(chainpos, channel, sampleRate, parameters);
 }
 
 
 template <const ChainPosition chainPos, typename ParamType>
-void initializeChainLink(MonoFilterChain& chain, Channel channel, juce::AudioProcessorValueTreeState& apvts, float rampTime, bool onRealTimeThread, double sampleRate)
+void initializeChainLink(MonoFilterChain& chain, Channel channel, const ParameterTable& parameters, float rampTime, bool onRealTimeThread, double sampleRate)
 {
-    ParamType params = getFilterParams<ParamType>(chainPos, channel, sampleRate, apvts);
+    ParamType params = getFilterParams<ParamType>(chainPos, channel, sampleRate, parameters);
     chain.get<static_cast<int>(chainPos)>().initialize(params, rampTime, onRealTimeThread, sampleRate);
 }
 
-inline void initializeFilters(ChainHelpers::MonoFilterChain& chain, Channel channel, juce::AudioProcessorValueTreeState& apvts, float rampTime, bool onRealTimeThread,   double sampleRate)
+inline void initializeFilters(ChainHelpers::MonoFilterChain& chain, Channel channel, const ParameterTable& parameters, float rampTime, bool onRealTimeThread,   double sampleRate)
 {
     // initialize filters
-    initializeChainLink<ChainPosition::LowShelf, FilterParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
-    initializeChainLink<ChainPosition::PeakFilter1, FilterParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
-    initializeChainLink<ChainPosition::PeakFilter2, FilterParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
-    initializeChainLink<ChainPosition::PeakFilter3, FilterParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
-    initializeChainLink<ChainPosition::PeakFilter4, FilterParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
-    initializeChainLink<ChainPosition::HighShelf, FilterParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::LowShelf, FilterParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::PeakFilter1, FilterParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::PeakFilter2, FilterParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::PeakFilter3, FilterParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::PeakFilter4, FilterParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::HighShelf, FilterParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
     //low cut filter, and then high cut
    
-    initializeChainLink<ChainPosition::LowCut, HighCutLowCutParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
-    initializeChainLink<ChainPosition::HighCut, HighCutLowCutParameters>(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::LowCut, HighCutLowCutParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
+    initializeChainLink<ChainPosition::HighCut, HighCutLowCutParameters>(chain, channel, parameters, rampTime, onRealTimeThread, sampleRate);
+}
+
+// the magnitude of the whole chain at frequency, bypassed links are flat
+inline double getMagnitudeForFrequency(MonoFilterChain& chain, double frequency)
+{
+    double mag {1.0};
+    
+    mag *= chain.get<0>().isBypassed() ? 1.0 : chain.get<0>().getCutFilterMagnitudeForFrequency(frequency);
+    mag *= chain.get<1>().isBypassed() ? 1.0 : chain.get<1>().getFilterMagnitudeForFrequency(frequency);
+    mag *= chain.get<2>().isBypassed() ? 1.0 : chain.get<2>().getFilterMagnitudeForFrequency(frequency);
+    mag *= chain.get<3>().isBypassed() ? 1.0 : chain.get<3>().getFilterMagnitudeForFrequency(frequency);
+    mag *= chain.get<4>().isBypassed() ? 1.0 : chain.get<4>().getFilterMagnitudeForFrequency(frequency);
+    mag *= chain.get<5>().isBypassed() ? 1.0 : chain.get<5>().getFilterMagnitudeForFrequency(frequency);
+    mag *= chain.get<6>().isBypassed() ? 1.0 : chain.get<6>().getFilterMagnitudeForFrequency(frequency);
+    mag *= chain.get<7>().isBypassed() ? 1.0 : chain.get<7>().getCutFilterMagnitudeForFrequency(frequency);
+    
+    return mag;
 }
 
 
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    CoefficientWorkerPool.cpp
+    Created: 18 Oct 2026 2:31:05pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "CoefficientWorkerPool.h"
+
+CoefficientWorkerPool::CoefficientWorkerPool() : CoefficientWorkerPool {"Coefficient Worker Thread"}
+{
+    startThread();
+}
+
+CoefficientWorkerPool::CoefficientWorkerPool(const juce::String& threadName) : Thread {threadName}
+{
+}
+
+CoefficientWorkerPool::~CoefficientWorkerPool()
+{
+    signalThreadShouldExit();
+    jobsWaiting.signal();
+
+    bool stopSucceeded = stopThread(2000);
+    jassert(stopSucceeded);
+}
+
+void CoefficientWorkerPool::submit(Job& job)
+{
+    if(job.queued.exchange(true))
+        return;
+
+    push(job);
+    jobsWaiting.signal();
+}
+
+bool CoefficientWorkerPool::isIdle(const Job& job) const
+{
+    // the worker sets currentJob before it clears queued, so check them in this order.
+    return ! job.queued.load() && currentJob.load() != &job;
+}
+
+void CoefficientWorkerPool::waitUntilIdle(Job& job)
+{
+    while(! isIdle(job))
+        juce::Thread::sleep(1);
+}
+
+void CoefficientWorkerPool::run()
+{
+    while(! threadShouldExit())
+    {
+        while(auto* job = pop())
+        {
+            currentJob.store(job);
+
+            // a submit from here on queues the job again, so nothing pushed while it runs is missed.
+            job->queued.store(false);
+            job->run();
+
+            currentJob.store(nullptr);
+        }
+
+        // A producer half way through a push leaves pop with nothing yet, but it signals once the
+        // push is done, so this only sleeps until it is.
+        jobsWaiting.wait();
+    }
+}
+
+void CoefficientWorkerPool::push(Job& job)
+{
+    job.next.store(nullptr, std::memory_order_relaxed);
+    auto* previous = head.exchange(&job);
+    previous->next.store(&job, std::memory_order_release);
+}
+
+CoefficientWorkerPool::Job* CoefficientWorkerPool::pop()
+{
+    auto* first = tail;
+    auto* next = first->next.load(std::memory_order_acquire);
+
+    if(first == &stub)
+    {
+        if(next == nullptr)
+            return nullptr;
+
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if(next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+
+    if(first != head.load())
+        return nullptr;
+
+    // first is the only job left, put the stub behind it so it can be handed out.
+    push(stub);
+    next = first->next.load(std::memory_order_acquire);
+
+    if(next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+
+    return nullptr;
+}
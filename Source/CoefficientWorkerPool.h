@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    CoefficientWorkerPool.h
+    Created: 18 Oct 2026 2:31:05pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <JuceHeader.h>
+#include "RealtimeSemaphore.h"
+
+// One background thread shared by every FilterCoefficientGenerator in the process, hold it
+// through a juce::SharedResourcePointer.  Jobs are queued on an intrusive multi producer, single
+// consumer queue (Vyukov's), so submitting never allocates or locks.  The worker sleeps on a
+// RealtimeSemaphore until something is submitted, so an idle pool never wakes at all.
+struct CoefficientWorkerPool : juce::Thread
+{
+    struct Job
+    {
+        virtual ~Job() = default;
+
+        // called on the worker thread
+        virtual void run() = 0;
+
+    private:
+        friend struct CoefficientWorkerPool;
+
+        std::atomic<Job*> next {nullptr};
+        std::atomic<bool> queued {false};
+    };
+
+    CoefficientWorkerPool();
+    ~CoefficientWorkerPool() override;
+
+    // Any thread, the audio thread included, it never allocates or locks.  A job that is already
+    // waiting is not queued twice, it will pick up whatever it needs when it runs.
+    void submit(Job& job);
+
+    // Whether the job is neither queued nor running, without waiting.
+    bool isIdle(const Job& job) const;
+
+    // Blocks until it is, call it before destroying a job.
+    void waitUntilIdle(Job& job);
+
+    void run() override;
+
+protected:
+    // For pools of their own, with a different name.  They start the thread once they're constructed
+    // themselves.
+    explicit CoefficientWorkerPool(const juce::String& threadName);
+
+private:
+    void push(Job& job);
+    Job* pop();
+
+    struct StubJob : Job
+    {
+        void run() override {}
+    };
+
+    StubJob stub;
+    std::atomic<Job*> head {&stub};     // producers push here
+    Job* tail {&stub};                  // the worker pops from here
+
+    std::atomic<Job*> currentJob {nullptr};
+
+    // one signal per job submitted, and one to stop
+    RealtimeSemaphore jobsWaiting;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoefficientWorkerPool)
+};
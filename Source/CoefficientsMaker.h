@@ -15,6 +15,8 @@
 #include "FilterParameters.h"
 #include "HighCutLowCutParameters.h"
 #include "HelperFunctions.h"
+#include "BiquadCoefficients.h"
+#include "FastMath.h"
 
 
 
@@ -22,76 +24,99 @@ struct CoefficientsMaker
 {
    
     
-    static auto makeCoefficients (FilterInfo::FilterType filterType,
-                                  float freq, float quality, float gain, double sampleRate)
+    static ParametricCoefficients makeCoefficients (FilterInfo::FilterType filterType,
+                                                    float freq, float quality, float gain, double sampleRate)
+    {
+        ParametricCoefficients coefficients;
+        coefficients.add(makeSection(filterType, freq, quality, gain, sampleRate));
+        return coefficients;
+    }
+    
+    static ParametricCoefficients makeCoefficients (FilterParameters filterParams)
+    {
+        return makeCoefficients(filterParams.filterType, filterParams.frequency, filterParams.quality,
+                                static_cast<float>(FastMath::decibelsToGain(filterParams.gain.getDb())), filterParams.sampleRate);
+    }
+    
+    
+    static CutCoefficients makeCoefficients (HighCutLowCutParameters filterParams)
+    {
+        if (filterParams.isLowcut)
+        {
+            return HelperFunctions::designIIRHighpassHighOrderButterworthMethod(filterParams.frequency,
+                                                                                               filterParams.sampleRate,
+                                                                                               filterParams.order, filterParams.quality);
+        }
+        
+        return HelperFunctions::designIIRLowpassHighOrderButterworthMethod(filterParams.frequency,
+                                                                                          filterParams.sampleRate,
+                                                                                          filterParams.order, filterParams.quality);
+    
+    }
+    
+private:
+    static BiquadCoefficients makeSection (FilterInfo::FilterType filterType,
+                                           float freq, float quality, float gain, double sampleRate)
     {
       using namespace FilterInfo;
-      using namespace juce::dsp::IIR;
+      using Coefficients = BiquadCoefficients;
+      
+      // a peak or shelf at 0 dB is flat, the identity section lets BiquadEngine skip it.
+      bool hasGain = filterType == FilterType::LowShelf || filterType == FilterType::HighShelf || filterType == FilterType::PeakFilter
+                  || filterType == FilterType::MatchedLowShelf || filterType == FilterType::MatchedHighShelf
+                  || filterType == FilterType::MatchedPeakFilter;
+        
+      if (hasGain && gain == 1.0f)
+          return {};
         
       switch (filterType)
       {
           case FilterType::FirstOrderLowPass:
-              return Coefficients<float>::makeFirstOrderLowPass(sampleRate, freq);
+              return Coefficients::makeFirstOrderLowPass(sampleRate, freq);
               
           case FilterType::FirstOrderHighPass:
-              return Coefficients<float>::makeFirstOrderHighPass(sampleRate, freq);
+              return Coefficients::makeFirstOrderHighPass(sampleRate, freq);
               
           case FilterType::FirstOrderAllPass:
-              return Coefficients<float>::makeFirstOrderAllPass(sampleRate, freq);
+              return Coefficients::makeFirstOrderAllPass(sampleRate, freq);
               
           case FilterType::LowPass:
-              return Coefficients<float>::makeLowPass(sampleRate, freq, quality);
+              return Coefficients::makeLowPass(sampleRate, freq, quality);
               
           case FilterType::HighPass:
-              return Coefficients<float>::makeHighPass(sampleRate, freq, quality);
+              return Coefficients::makeHighPass(sampleRate, freq, quality);
               
           case FilterType::BandPass:
-              return Coefficients<float>::makeBandPass(sampleRate, freq, quality);
+              return Coefficients::makeBandPass(sampleRate, freq, quality);
               
           case FilterType::Notch:
-              return Coefficients<float>::makeNotch(sampleRate, freq, quality);
+              return Coefficients::makeNotch(sampleRate, freq, quality);
               
           case FilterType::AllPass:
-              return Coefficients<float>::makeAllPass(sampleRate, freq, quality);
+              return Coefficients::makeAllPass(sampleRate, freq, quality);
               
           case FilterType::LowShelf:
-              return Coefficients<float>::makeLowShelf(sampleRate, freq, quality, gain);
+              return Coefficients::makeLowShelf(sampleRate, freq, quality, gain);
               
           case FilterType::HighShelf:
-              return Coefficients<float>::makeHighShelf(sampleRate, freq, quality, gain);
+              return Coefficients::makeHighShelf(sampleRate, freq, quality, gain);
               
           case FilterType::PeakFilter:
-              return Coefficients<float>::makePeakFilter(sampleRate, freq, quality, gain);
+              return Coefficients::makePeakFilter(sampleRate, freq, quality, gain);
+              
+          case FilterType::MatchedLowShelf:
+              return Coefficients::makeMatchedLowShelf(sampleRate, freq, quality, gain);
+              
+          case FilterType::MatchedHighShelf:
+              return Coefficients::makeMatchedHighShelf(sampleRate, freq, quality, gain);
+              
+          case FilterType::MatchedPeakFilter:
+              return Coefficients::makeMatchedPeakFilter(sampleRate, freq, quality, gain);
               
       }
-    }
-    
-    static auto makeCoefficients (FilterParameters filterParams)
-    {
-        return makeCoefficients(filterParams.filterType, filterParams.frequency, filterParams.quality, filterParams.gain.getGain(), filterParams.sampleRate);
-    }
-    
-    
-    static auto makeCoefficients (HighCutLowCutParameters filterParams)
-    {
-        if (filterParams.isLowcut)
-        {
-            return HelperFunctions::designIIRHighpassHighOrderButterworthMethod(filterParams.frequency,
-                                                                                               filterParams.sampleRate,
-                                                                                               filterParams.order, filterParams.quality);
-        }
         
-        return HelperFunctions::designIIRLowpassHighOrderButterworthMethod(filterParams.frequency,
-                                                                                          filterParams.sampleRate,
-                                                                                          filterParams.order, filterParams.quality);
-    
+      jassertfalse;
+      return {};
     }
     
 };
-
-
-
-// convenience types
-
-using FilterCoeffPtr = decltype(CoefficientsMaker::makeCoefficients (FilterParameters()));
-using CutCoeffArray = decltype(CoefficientsMaker::makeCoefficients (HighCutLowCutParameters()));
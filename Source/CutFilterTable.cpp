@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    CutFilterTable.cpp
+    Created: 18 Oct 2026 3:47:19pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "CutFilterTable.h"
+#include "FastMath.h"
+
+CutFilterTable::CutFilterTable()
+{
+    using Constants = juce::MathConstants<double>;
+
+    // slopes are per grid step, which is what the interpolation wants.
+    for(int i = 0; i < numPoints; ++i)
+    {
+        auto normalisedFrequency = std::exp2(lowestOctave + static_cast<double>(i) / pointsPerOctave);
+        auto omega = Constants::pi * normalisedFrequency;
+        auto omegaPerStep = omega * std::log(2.0) / pointsPerOctave;
+
+        auto& point = grid[static_cast<size_t>(i)];
+        point.sin = std::sin(omega);
+        point.cos = std::cos(omega);
+        point.sinSlope = point.cos * omegaPerStep;
+        point.cosSlope = -point.sin * omegaPerStep;
+    }
+
+    // same pole angles as the juce high order Butterworth designs
+    for(int order = 2; order <= maxOrder; ++order)
+    {
+        for(int section = 0; section < order / 2; ++section)
+        {
+            auto angle = (order % 2 == 1) ? (section + 1.0) * Constants::pi / order
+                                          : (2.0 * section + 1.0) * Constants::pi / (order * 2.0);
+
+            sectionDivisors[static_cast<size_t>(order)][static_cast<size_t>(section)] = 2.0 * std::cos(angle);
+        }
+    }
+}
+
+double CutFilterTable::getPrewarpedFrequency(double frequency, double sampleRate) const
+{
+    jassert(sampleRate > 0.0);
+    jassert(frequency > 0 && frequency <= sampleRate * 0.5);
+
+    auto normalisedFrequency = frequency / sampleRate;
+    auto position = (FastMath::log2(normalisedFrequency) - lowestOctave) * pointsPerOctave;
+
+    // off the grid (or right at Nyquist), just work it out
+    if(position < 0.0 || position >= numPoints - 1)
+        return FastMath::tan(juce::MathConstants<double>::pi * normalisedFrequency);
+
+    auto index = static_cast<size_t>(position);
+    auto t = position - static_cast<double>(index);
+    auto t2 = t * t;
+    auto t3 = t2 * t;
+
+    auto h00 = 2.0 * t3 - 3.0 * t2 + 1.0;
+    auto h10 = t3 - 2.0 * t2 + t;
+    auto h01 = 3.0 * t2 - 2.0 * t3;
+    auto h11 = t3 - t2;
+
+    const auto& p0 = grid[index];
+    const auto& p1 = grid[index + 1];
+
+    auto sin = h00 * p0.sin + h10 * p0.sinSlope + h01 * p1.sin + h11 * p1.sinSlope;
+    auto cos = h00 * p0.cos + h10 * p0.cosSlope + h01 * p1.cos + h11 * p1.cosSlope;
+
+    return sin / cos;
+}
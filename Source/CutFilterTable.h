@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    CutFilterTable.h
+    Created: 18 Oct 2026 3:47:19pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <JuceHeader.h>
+#include "BiquadCoefficients.h"
+
+// Precomputed pieces of the Butterworth cut designs, so a smoothed step costs a lookup instead of
+// a tan per section.  Every section of a cut filter shares one prewarped frequency, tan(pi f / fs),
+// which is read off a log spaced grid over the normalised frequency f / fs and so works at any
+// sample rate.  The grid holds sin and cos with their slopes for cubic Hermite interpolation, which
+// stays within about 1e-7 of the exact value right up to Nyquist, where tan itself does not interpolate well.
+// The per order pole angles of the sections are tabled as well.
+struct CutFilterTable
+{
+    static constexpr int maxOrder = 2 * static_cast<int>(CutCoefficients::maxSections);
+
+    // Built on first use.  The first design happens when the filters are initialised in
+    // prepareToPlay, so the audio thread never pays for it.
+    static const CutFilterTable& getInstance()
+    {
+        static const CutFilterTable table;
+        return table;
+    }
+
+    // tan(pi * frequency / sampleRate)
+    double getPrewarpedFrequency(double frequency, double sampleRate) const;
+
+    // 2 cos of the pole angle of a second order section, the section's Q is the design's Q scale over this.
+    double getSectionDivisor(int order, int section) const
+    {
+        jassert(order > 1 && order <= maxOrder);
+        jassert(section >= 0 && section < order / 2);
+
+        return sectionDivisors[static_cast<size_t>(order)][static_cast<size_t>(section)];
+    }
+
+private:
+    CutFilterTable();
+
+    static constexpr int pointsPerOctave = 32;
+    static constexpr int lowestOctave = -16;    // 2^-16 of the sample rate, under 12 Hz at 4x 192 kHz
+    static constexpr int numOctaves = 15;       // up to Nyquist
+    static constexpr int numPoints = numOctaves * pointsPerOctave + 1;
+
+    struct GridPoint
+    {
+        double sin, cos, sinSlope, cosSlope;
+    };
+
+    std::array<GridPoint, numPoints> grid;
+    std::array<std::array<double, CutCoefficients::maxSections>, maxOrder + 1> sectionDivisors {};
+};
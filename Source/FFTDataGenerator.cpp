@@ -19,6 +19,13 @@ void FFTDataGenerator::produceFFTDataForRendering(const juce::AudioBuffer<float>
     
     jassert(size == audioData.getNumSamples());
     
+    // nowhere to put it until the consumer catches up, so this block is skipped
+    auto* slot = fftDataFifo.claim();
+    if(slot == nullptr)
+        return;
+    
+    auto& fftData = *slot;
+    
     auto readPointer = audioData.getReadPointer(0);  //single channel
 
     // copy all of the samples from audioData into fftData, first half
@@ -46,8 +53,8 @@ void FFTDataGenerator::produceFFTDataForRendering(const juce::AudioBuffer<float>
      }
     
   
-    // finally, push fftData into the Fifo for others to consume.
-    fftDataFifo.push(fftData);
+    // finally, hand fftData over to the consumer.
+    fftDataFifo.commit();
 }
 
 
@@ -60,9 +67,7 @@ void FFTDataGenerator::changeOrder(FFTOrder newOrder)
     // the forwardFFT
     forwardFFT = std::make_unique<juce::dsp::FFT>(static_cast<int>(order));
     // the fftData, filled with zeros
-    fftData.assign(2 * size, 0.f);
-    
-    fftDataFifo.prepare(2 * size);
+    fftDataFifo.prepare([size](std::vector<float>& fftData) { fftData.assign(2 * size, 0.f); });
 }
 
 size_t FFTDataGenerator::getNumAvailableFFTDataBlocks() const
@@ -70,7 +75,12 @@ size_t FFTDataGenerator::getNumAvailableFFTDataBlocks() const
    return fftDataFifo.getNumAvailableForReading();
 }
 
-bool FFTDataGenerator::getFFTData(std::vector<float>& fftData)
+const std::vector<float>* FFTDataGenerator::getNextFFTData()
+{
+   return fftDataFifo.front();
+}
+
+void FFTDataGenerator::releaseFFTData()
 {
-   return fftDataFifo.exchange(fftData);
+   fftDataFifo.pop();
 }
@@ -11,7 +11,7 @@
 #pragma once
 #include <vector>
 #include <JuceHeader.h>
-#include "Fifo.h"
+#include "SpscRing.h"
 #include "AnalyzerProperties.h"
 
 #define FFT_FIFO_DEPTH 100
@@ -30,13 +30,16 @@ struct FFTDataGenerator
     size_t getFFTSize() const { return 1 << static_cast<int>(order); }
     
     size_t getNumAvailableFFTDataBlocks() const;
-    bool getFFTData(std::vector<float>& fftData);
+    
+    // the oldest block, read where it is, until releaseFFTData() hands it back
+    const std::vector<float>* getNextFFTData();
+    void releaseFFTData();
     
 private:
     AnalyzerProperties::FFTOrder order;
-    std::vector<float> fftData;
     std::unique_ptr<juce::dsp::FFT> forwardFFT;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
     
-    Fifo<std::vector<float>, FFT_FIFO_DEPTH> fftDataFifo;
+    // each block is transformed in its own slot, 2 * the FFT size for the transform's working space
+    SpscRing<std::vector<float>, FFT_FIFO_DEPTH> fftDataFifo;
 };
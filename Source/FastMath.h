@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 18 Oct 2026 1:12:37pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <JuceHeader.h>
+
+// Replacements for the libm calls the coefficient designs make.  Each one is a range reduction
+// followed by a fixed length polynomial, so the cost does not depend on the argument and there
+// are no slow paths for the audio thread to fall into.  Everything is done in double and is
+// accurate to around 1e-12 relative, far below the float resolution the coefficients end up in.
+namespace FastMath
+{
+    constexpr double ln2 = 0.69314718055994530942;
+
+    // sin and cos together, which is what the designs want anyway.
+    inline void sinCos(double x, double& sinOut, double& cosOut)
+    {
+        // reduce to [-pi/4, pi/4], with pi/2 split in two so the reduction itself stays exact.
+        constexpr double twoOverPi = 0.63661977236758134308;
+        constexpr double halfPiHigh = 1.57079632673412561417;
+        constexpr double halfPiLow = 6.07710050650619224932e-11;
+
+        auto quadrant = std::floor(x * twoOverPi + 0.5);
+        auto r = (x - quadrant * halfPiHigh) - quadrant * halfPiLow;
+        auto r2 = r * r;
+
+        auto s = r + r * r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0
+                   + r2 * (-1.0 / 39916800.0 + r2 * (1.0 / 6227020800.0))))));
+        auto c = 1.0 + r2 * (-0.5 + r2 * (1.0 / 24.0 + r2 * (-1.0 / 720.0 + r2 * (1.0 / 40320.0
+                   + r2 * (-1.0 / 3628800.0 + r2 * (1.0 / 479001600.0 + r2 * (-1.0 / 87178291200.0)))))));
+
+        switch (static_cast<int64_t>(quadrant) & 3)
+        {
+            case 0:  sinOut = s;  cosOut = c;  break;
+            case 1:  sinOut = c;  cosOut = -s; break;
+            case 2:  sinOut = -s; cosOut = -c; break;
+            default: sinOut = -c; cosOut = s;  break;
+        }
+    }
+
+    // sin for x already in [-pi/2, pi/2], one polynomial with no reduction and no branches.  For the
+    // designs that know where their angles are.
+    inline double sinInRange(double x)
+    {
+        jassert(std::abs(x) <= 0.5 * juce::MathConstants<double>::pi + 1.0e-9);
+
+        auto x2 = x * x;
+        return x + x * x2 * (-1.0 / 6.0 + x2 * (1.0 / 120.0 + x2 * (-1.0 / 5040.0 + x2 * (1.0 / 362880.0
+                   + x2 * (-1.0 / 39916800.0 + x2 * (1.0 / 6227020800.0 + x2 * (-1.0 / 1307674368000.0
+                   + x2 * (1.0 / 355687428096000.0))))))));
+    }
+
+    // cos for x in [0, pi]
+    inline double cosInRange(double x)
+    {
+        return sinInRange(0.5 * juce::MathConstants<double>::pi - x);
+    }
+
+    inline double sin(double x)
+    {
+        double s, c;
+        sinCos(x, s, c);
+        return s;
+    }
+
+    inline double cos(double x)
+    {
+        double s, c;
+        sinCos(x, s, c);
+        return c;
+    }
+
+    inline double tan(double x)
+    {
+        double s, c;
+        sinCos(x, s, c);
+        return s / c;
+    }
+
+    inline double exp2(double x)
+    {
+        x = juce::jlimit(-1020.0, 1020.0, x);
+
+        // 2^x = 2^n * e^(f ln2) with |f| <= 0.5.  Adding and taking away 1.5 * 2^52 rounds to the nearest
+        // whole number in two adds, where std::floor is a library call on plain x86-64.
+        constexpr double roundingShift = 6755399441055744.0;
+        auto n = (x + roundingShift) - roundingShift;
+        auto t = (x - n) * ln2;
+
+        auto p = 1.0 + t * (1.0 + t * (1.0 / 2.0 + t * (1.0 / 6.0 + t * (1.0 / 24.0 + t * (1.0 / 120.0
+                   + t * (1.0 / 720.0 + t * (1.0 / 5040.0 + t * (1.0 / 40320.0 + t * (1.0 / 362880.0
+                   + t * (1.0 / 3628800.0))))))))));
+
+        auto bits = static_cast<uint64_t>(static_cast<int64_t>(n) + 1023) << 52;
+        double scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+
+        return p * scale;
+    }
+
+    // x must be positive and normal
+    inline double log2(double x)
+    {
+        jassert(x > 0.0);
+
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        auto exponent = static_cast<double>(static_cast<int64_t>((bits >> 52) & 0x7ff) - 1023);
+        bits = (bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+
+        double m;
+        std::memcpy(&m, &bits, sizeof(m));
+
+        // keep the mantissa in [sqrt(1/2), sqrt(2)) so the series below converges quickly.
+        if (m > juce::MathConstants<double>::sqrt2)
+        {
+            m *= 0.5;
+            exponent += 1.0;
+        }
+
+        // ln(m) = 2 atanh(s)
+        auto s = (m - 1.0) / (m + 1.0);
+        auto s2 = s * s;
+        auto lnM = 2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0 + s2 * (1.0 / 7.0 + s2 * (1.0 / 9.0
+                   + s2 * (1.0 / 11.0 + s2 * (1.0 / 13.0)))))));
+
+        return exponent + lnM / ln2;
+    }
+
+    inline double pow(double base, double exponent)
+    {
+        return exp2(exponent * log2(base));
+    }
+
+    // same -100 dB floor as juce::Decibels::decibelsToGain
+    inline double decibelsToGain(double decibels)
+    {
+        constexpr double log2Of10Over20 = 0.16609640474436811739;
+        return decibels > -100.0 ? exp2(decibels * log2Of10Over20) : 0.0;
+    }
+}
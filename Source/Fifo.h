@@ -13,6 +13,8 @@
 #include <JuceHeader.h>
 #include "CoeffTypeHelpers.h"
 
+// Superseded by SpscRing, which the plugin's queues use now.  Kept as the baseline FifoBenchmark
+// measures against.
 template<typename T, size_t Size>
 struct Fifo
 {
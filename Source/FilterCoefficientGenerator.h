@@ -11,55 +11,43 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "Fifo.h"
+#include "LatestValueSlot.h"
+#include "CoefficientWorkerPool.h"
 #include "CoefficientsMaker.h"
 
-template <typename CoefficientType, typename ParamType, typename MakeFunction, size_t Size>
-struct FilterCoefficientGenerator : juce::Thread
+// Makes coefficients off the audio thread, on the worker shared by every generator in the process.
+// Parameters and coefficients both travel by value through LatestValueSlots, so nothing here
+// allocates once it is constructed.
+template <typename CoefficientType, typename ParamType, typename MakeFunction>
+struct FilterCoefficientGenerator : CoefficientWorkerPool::Job
 {
-    FilterCoefficientGenerator(Fifo <CoefficientType, Size>& processFifo) : Thread {"Coefficient Maker Thread"}, coeffFifo {processFifo}
+    FilterCoefficientGenerator(LatestValueSlot<CoefficientType>& processSlot) : coefficientSlot {processSlot}
     {
-        startThread();
     }
-    
+
     ~FilterCoefficientGenerator() override
     {
-        bool stopSucceeded =  stopThread(2000);
-        jassert(stopSucceeded);
+        workerPool->waitUntilIdle(*this);
     }
-    
+
     void changeParameters(ParamType params)
     {
-        paramFifo.push(params);
-        paramChanged.set(true);
+        paramSlot.push(params);
+        workerPool->submit(*this);
     }
-    
+
     void run() override
     {
-        while(! threadShouldExit())
-        {
-            wait (waitTime);
-            if (paramChanged.compareAndSetBool (false, true))
-            {
-              //  DBG("Coef Gen fifo depth:" + std::to_string(paramFifo.getNumAvailableForReading()));
-                while (paramFifo.getNumAvailableForReading() >0)
-                {
-                    ParamType params;
-                    paramFifo.pull(params);
-                    auto coeffs = MakeFunction::makeCoefficients(params);
-                    coeffFifo.push(coeffs);
-                }
-            }
-            
-        }
+        // only the newest parameters matter, anything older has been overwritten.
+        ParamType params;
+        if (paramSlot.pull(params))
+            coefficientSlot.push(MakeFunction::makeCoefficients(params));
     }
 private:
-    int waitTime = 10;  //ms
-    
-    Fifo <CoefficientType, Size>& coeffFifo;
-    Fifo <ParamType, 100> paramFifo;
-    
-    juce::Atomic<bool> paramChanged{false};
-    
+    LatestValueSlot<CoefficientType>& coefficientSlot;
+    LatestValueSlot<ParamType> paramSlot;
+
+    juce::SharedResourcePointer<CoefficientWorkerPool> workerPool;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterCoefficientGenerator)
 };
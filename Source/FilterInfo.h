@@ -28,7 +28,10 @@ namespace FilterInfo
         AllPass,
         LowShelf,
         HighShelf,
-        PeakFilter
+        PeakFilter,
+        MatchedLowShelf,
+        MatchedHighShelf,
+        MatchedPeakFilter
     };
 
     enum class Slope
@@ -55,7 +58,10 @@ namespace FilterInfo
         {FilterType::AllPass, "All Pass"},
         {FilterType::LowShelf, "Low Shelf"},
         {FilterType::HighShelf, "High Shelf"},
-        {FilterType::PeakFilter, "Peak Filter"}
+        {FilterType::PeakFilter, "Peak Filter"},
+        {FilterType::MatchedLowShelf, "Matched Low Shelf"},
+        {FilterType::MatchedHighShelf, "Matched High Shelf"},
+        {FilterType::MatchedPeakFilter, "Matched Peak Filter"}
        
     };
 
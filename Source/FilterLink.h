@@ -10,49 +10,39 @@
 
 #pragma once
 
+// When true the coefficients are made by FilterCoefficientGenerators on the shared CoefficientWorkerPool.
+// When false they are made right on the audio thread, see FastMath.h, and the pool is never started.
+#define USE_COEFFICIENT_THREADS false
+
 #include "FilterCoefficientGenerator.h"
-#include "ReleasePool.h"
-#include "Fifo.h"
+#include "LatestValueSlot.h"
 #include "Decibel.h"
-#include "CoeffTypeHelpers.h"
+#include "BiquadCoefficients.h"
 
-// FifoDataType is for example ReferenceCountedObjectPtr or ReferenceCountedArray
 // ParamType is one of the FilterParameters types.
 // Function type is going to be CoefficientsMaker for now.
-// FilterType is juce::dsp::IIR::Filter<float> or a chain of them.
+// CoefficientType is whatever FunctionType makes from ParamType, a CascadeCoefficients of one
+// section for the parametric bands or up to four for the cut filters.
+// The link only owns parameters, smoothing and coefficients, the samples go through BiquadEngine.
 
-template <typename FilterType, typename FifoDataType,  typename ParamType, typename FunctionType>
+template <typename ParamType, typename FunctionType>
 struct FilterLink
 {
-    void prepare(const juce::dsp::ProcessSpec& spec)
-    {
-        filter.prepare(spec);
-    }
-    
-    void reset()
-    {
-        filter.reset();
-    }
+    using CoefficientType = decltype(FunctionType::makeCoefficients(ParamType()));
     
-    template<typename ContextType>
-    void process(const ContextType& context)
-    {
-        if(! currentParams.bypassed)
-           filter.process(context);
-    }
-    
-    void updateSmootherTargets()
+    // the smoothers head for the current parameters from wherever they are, taking rampTime to get there
+    void updateSmootherTargets(float rampTime)
     {
         if(freqSmoother.getTargetValue()  != currentParams.frequency)
-            freqSmoother.setTargetValue(currentParams.frequency);
+            retarget(freqSmoother, currentParams.frequency, rampTime);
         
         if(qualitySmoother.getTargetValue()  != currentParams.quality)
-            qualitySmoother.setTargetValue(currentParams.quality);
+            retarget(qualitySmoother, currentParams.quality, rampTime);
         
         if constexpr (std::is_same<FilterParameters, ParamType>::value)
         {
             if(gainSmoother.getTargetValue()  != currentParams.gain)
-                gainSmoother.setTargetValue(currentParams.gain);
+                retarget(gainSmoother, currentParams.gain, rampTime);
         }
     }
     
@@ -83,6 +73,17 @@ struct FilterLink
         return result;
     }
     
+    // Nothing left for the inner loop to do until the parameters change again.  A bypassed link is
+    // an identity section whatever its smoothers are doing, and coefficients from a generator can
+    // turn up at any time, so a link with one never settles.
+    bool isSettled() const
+    {
+        if(coeffGen != nullptr)
+            return false;
+        
+        return currentParams.bypassed || (! isSmoothing() && ! shouldComputeNewCoefficients.get());
+    }
+    
     void checkIfStillSmoothing()
     {
         shouldComputeNewCoefficients = isSmoothing();
@@ -110,41 +111,27 @@ struct FilterLink
     }
 
     //stuff for updating the coefficients from processBlock, prepareToPlay, or setStateInformation
-    void updateCoefficients(const FifoDataType& coefficents)
+    void updateCoefficients(const CoefficientType& newCoefficients)
     {
-        if constexpr( isReferenceCountedObjectPtr<FifoDataType>::value )
-        {
-            updateFilterState(filter.coefficients, coefficents);
-        }
-        else if constexpr ( isReferenceCountedArray<FifoDataType>::value )
-        {
-            configureCutFilterChain(coefficents);
-        }
-        else
-        {
-            jassertfalse;  // this should not happen
-        }
+        coefficients = newCoefficients;
     }
         
-    void loadCoefficients(bool fromFifo)
+    void loadCoefficients(bool fromGenerator)
     {
-        if(fromFifo)
+        if(fromGenerator)
         {
-            FifoDataType newCoefficients;
+            // without a generator generateNewCoefficientsIfNeeded has already made them.
+            CoefficientType newCoefficients;
             
-//            if(coeffFifo.getNumAvailableForReading() > 0)
-//                DBG("Filter Link fifo depth:" + std::to_string(coeffFifo.getNumAvailableForReading()));
-            
-            while(coeffFifo.pull(newCoefficients))
-            {
+            if(coefficientSlot.pull(newCoefficients))
                 updateCoefficients(newCoefficients);
-            }
         }
         else
         {
             updateCoefficients(FunctionType::makeCoefficients(currentParams));
         }
     }
+
     void generateNewCoefficientsIfNeeded()
     {
         if(shouldComputeNewCoefficients.compareAndSetBool(false,true))
@@ -158,15 +145,18 @@ struct FilterLink
                     newParams.gain = gainSmoother.getCurrentValue();
             }
             
-            coeffGen.changeParameters(newParams);
+            if(coeffGen != nullptr)
+                coeffGen->changeParameters(newParams);
+            else
+                updateCoefficients(FunctionType::makeCoefficients(newParams));
         }
     }
     
     //stuff for configuring the filter before processing
-    void performPreloopUpdate(const ParamType& params)
+    void performPreloopUpdate(const ParamType& params, float rampTime)
     {
         updateParams(params);
-        updateSmootherTargets();
+        updateSmootherTargets(rampTime);
     }
     
     void performInnerLoopFilterUpdate(bool onRealTimeThread, int numSamplesToSkip)
@@ -174,10 +164,13 @@ struct FilterLink
         if(currentParams.bypassed)
             return;
         
+        // move the smoothers to the end of the block first, the filter engine ramps
+        // from the previous coefficients to these over the block.
+        advanceSmoothers(numSamplesToSkip);
+        
         generateNewCoefficientsIfNeeded();
         loadCoefficients(onRealTimeThread);
         
-        advanceSmoothers(numSamplesToSkip);
         checkIfStillSmoothing();
     }
     
@@ -185,6 +178,13 @@ struct FilterLink
     {
         currentParams = params;
         sampleRate = sr;
+        
+       #if USE_COEFFICIENT_THREADS
+        // only links that run on the audio thread get a generator, the response curve makes its own.
+        if(onRealTimeThread && coeffGen == nullptr)
+            coeffGen = std::make_unique<GeneratorType>(coefficientSlot);
+       #endif
+        
         shouldComputeNewCoefficients = true;
         generateNewCoefficientsIfNeeded();
         loadCoefficients(onRealTimeThread);
@@ -200,60 +200,37 @@ struct FilterLink
     
     double getCutFilterMagnitudeForFrequency(double frequency)
     {
-        double mag {1};
-        mag *=  filter.template isBypassed<0>() ? 1.0 : filter.template get<0>().coefficients->getMagnitudeForFrequency (frequency, sampleRate);
-        mag *=  filter.template isBypassed<1>() ? 1.0 : filter.template get<1>().coefficients->getMagnitudeForFrequency (frequency, sampleRate);
-        mag *=  filter.template isBypassed<2>() ? 1.0 : filter.template get<2>().coefficients->getMagnitudeForFrequency (frequency, sampleRate);
-        mag *=  filter.template isBypassed<3>() ? 1.0 : filter.template get<3>().coefficients->getMagnitudeForFrequency (frequency, sampleRate);
-        return mag;
+        return coefficients.getMagnitudeForFrequency (frequency, sampleRate);
     }
     
     double getFilterMagnitudeForFrequency(double frequency)
     {
-        return filter.coefficients->getMagnitudeForFrequency (frequency, sampleRate);
+        return coefficients.getMagnitudeForFrequency (frequency, sampleRate);
     }
     
-private:
-    //stuff for setting the coefficients of the FilterType instance.
-    template <typename Obj>
-    void updateFilterState(juce::ReferenceCountedObjectPtr<Obj>& oldState ,juce::ReferenceCountedObjectPtr<Obj> newState)
+    // hands the current sections to a BiquadEngine lane, unused or bypassed sections become identity sections.
+    template <typename EngineType>
+    void copyCoefficientsToEngine(EngineType& engine, size_t firstSection, size_t lane)
     {
-        *oldState = *newState;
-        releasePool.add(newState);
-    }
-    
-    void configureCutFilterChain(const FifoDataType& coefficients)
-    {
-        // assumes CutFilter has 4 filters.
-        filter.template setBypassed<0>(true);
-        filter.template setBypassed<1>(true);
-        filter.template setBypassed<2>(true);
-        filter.template setBypassed<3>(true);
-        
-        int order {coefficients.size()};
-        switch(order)
+        for(size_t i = 0; i < CoefficientType::maxSections; ++i)
         {
-            case 4:
-                updateFilterState(filter.template get<3>().coefficients, coefficients[3]);
-                filter.template setBypassed<3>(false);
-            case 3:
-                updateFilterState(filter.template get<2>().coefficients, coefficients[2]);
-                filter.template setBypassed<2>(false);
-            case 2:
-                updateFilterState(filter.template get<1>().coefficients, coefficients[1]);
-                filter.template setBypassed<1>(false);
-            case 1:
-                updateFilterState(filter.template get<0>().coefficients, coefficients[0]);
-                filter.template setBypassed<0>(false);
+            if(currentParams.bypassed || i >= coefficients.numSections)
+                engine.setCoefficients(firstSection + i, lane, BiquadCoefficients());
+            else
+                engine.setCoefficients(firstSection + i, lane, coefficients.sections[i]);
         }
     }
     
-    // magic numebrs
-    static const int fifoSize = 100;
-    static const int poolSize = 50000;
-    static const int cleanupInterval = 2000; // ms
-
-    using Coefficients = juce::dsp::IIR::Coefficients<float>;
+private:
+    template <typename ValueType>
+    void retarget(juce::SmoothedValue<ValueType>& smoother, ValueType target, float rampTime)
+    {
+        // reset() jumps to the old target, so carry the current value over to the new ramp
+        auto current = smoother.getCurrentValue();
+        smoother.reset(sampleRate, rampTime);
+        smoother.setCurrentAndTargetValue(current);
+        smoother.setTargetValue(target);
+    }
     
     float sampleRate;
     
@@ -261,10 +238,11 @@ private:
     
     juce::Atomic <bool> shouldComputeNewCoefficients{true};
  
-    ReleasePool<Coefficients, poolSize> releasePool {poolSize, cleanupInterval};
-    Fifo <FifoDataType, fifoSize>  coeffFifo;
-    FilterCoefficientGenerator<FifoDataType, ParamType, CoefficientsMaker, fifoSize> coeffGen {coeffFifo};
-    FilterType filter;
+    CoefficientType coefficients;
+    LatestValueSlot<CoefficientType> coefficientSlot;
+    
+    using GeneratorType = FilterCoefficientGenerator<CoefficientType, ParamType, FunctionType>;
+    std::unique_ptr<GeneratorType> coeffGen;
     
     // Smoothers
     juce::SmoothedValue<float> freqSmoother;
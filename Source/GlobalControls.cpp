@@ -15,19 +15,28 @@
 GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apv, NodeController& nodeController):apvts(apv), nodeControl(nodeController),
                                inGain(apv, GlobalParameters::inTrimName),
                                outGain(apv, GlobalParameters::outTrimName),
-                               processingMode(apv, GlobalParameters::processingModeName), analyzerControls(apv)
+                               processingMode(apv, GlobalParameters::processingModeName),
+                               oversampling(apv, GlobalParameters::oversamplingName),
+                               filterDesign(apv, GlobalParameters::filterDesignName),
+                               phaseMode(apv, GlobalParameters::phaseModeName), analyzerControls(apv)
 {
     setLookAndFeel(&lookAndFeel);
     
     addAndMakeVisible(inGainBox);
     addAndMakeVisible(outGainBox);
     addAndMakeVisible(modeBox);
+    addAndMakeVisible(oversamplingBox);
+    addAndMakeVisible(designBox);
+    addAndMakeVisible(phaseBox);
     addAndMakeVisible(resetBox);
     
     addAndMakeVisible(analyzerControls);
     addAndMakeVisible(outGain);
     addAndMakeVisible(inGain);
     addAndMakeVisible(processingMode);
+    addAndMakeVisible(oversampling);
+    addAndMakeVisible(filterDesign);
+    addAndMakeVisible(phaseMode);
     addAndMakeVisible(resetAllBands);
     
     
@@ -58,6 +67,19 @@ void GlobalControls::resized()
     auto procModeBounds = bounds.removeFromLeft(controlWidth);
     bounds.removeFromLeft(static_cast<int>((processingModeAspectRatio - 1.0f) * controlWidth)); // remove rest of rectangle
     
+    // the other switches are laid out the same way
+    auto placeSwitch = [&](BoundaryBox& box)
+    {
+        box.setBounds(bounds.withWidth(static_cast<int>(processingModeAspectRatio * controlWidth)));
+        auto switchBounds = bounds.removeFromLeft(controlWidth);
+        bounds.removeFromLeft(static_cast<int>((processingModeAspectRatio - 1.0f) * controlWidth));
+        return switchBounds;
+    };
+    
+    auto oversamplingBounds = placeSwitch(oversamplingBox);
+    auto designBounds = placeSwitch(designBox);
+    auto phaseBounds = placeSwitch(phaseBox);
+    
     auto analyzerControlBounds =  bounds.removeFromLeft(static_cast<int>(bounds.getHeight() * analyzerControlAspectRatio));
     inGain.setBounds(inTrimBounds);
     inGainBox.setBounds(inTrimBounds);
@@ -66,6 +88,9 @@ void GlobalControls::resized()
     outGainBox.setBounds(outTrimBounds);
     
     processingMode.setBounds(procModeBounds);
+    oversampling.setBounds(oversamplingBounds);
+    filterDesign.setBounds(designBounds);
+    phaseMode.setBounds(phaseBounds);
     
     analyzerControls.setBounds(analyzerControlBounds);
     
@@ -35,9 +35,9 @@ private:
     NodeController& nodeControl;
     
     BottomControl<RotarySlider> inGain, outGain;
-    BottomControl<SwitchSlider> processingMode;
+    BottomControl<SwitchSlider> processingMode, oversampling, filterDesign, phaseMode;
 
-    BoundaryBox inGainBox,  outGainBox, modeBox, resetBox;
+    BoundaryBox inGainBox,  outGainBox, modeBox, oversamplingBox, designBox, phaseBox, resetBox;
     
     AnalyzerControls analyzerControls;
     
@@ -17,4 +17,17 @@ namespace GlobalParameters
 const juce::String processingModeName{"Processing Mode"};
 const juce::String inTrimName{"In Trim"};
 const juce::String outTrimName{"Out Trim"};
+const juce::String oversamplingName{"Oversampling"};
+
+// the choice index is the oversampling order, the filters run at 2^index times the host rate
+const juce::StringArray oversamplingChoices{"Off", "2x", "4x"};
+constexpr int maxOversamplingOrder = 2;
+
+// how the shelves and peaks are made, bilinear (RBJ) or magnitude matched to the analog prototype
+const juce::String filterDesignName{"Filter Design"};
+const juce::StringArray filterDesignChoices{"Bilinear", "Matched"};
+
+// minimum phase runs the IIR chains, linear phase an FIR with the same magnitude response
+const juce::String phaseModeName{"Phase"};
+const juce::StringArray phaseModeChoices{"Minimum", "Linear"};
 }
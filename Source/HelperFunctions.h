@@ -10,86 +10,65 @@
 
 #pragma once
 
+#include "BiquadCoefficients.h"
+#include "CutFilterTable.h"
+#include "FastMath.h"
+
 namespace HelperFunctions {
 
     using namespace juce;
     using namespace juce::dsp;
 
-    template <typename FloatType>
-    ReferenceCountedArray<IIR::Coefficients<FloatType>>
-         designIIRLowpassHighOrderButterworthMethod (FloatType frequency, double sampleRate, int order, float quality)
+    // Q scale shared by the second order sections, see CutFilterTable::getSectionDivisor
+    inline double getButterworthQualityScale(int order, float quality)
+    {
+        // n is zero for a first order filter, which has no second order sections to spread the quality over.
+        int n = order / 2;
+        return n > 0 ? FastMath::pow(quality * MathConstants<double>::sqrt2, 1.0 / static_cast<double> (n)) : 1.0;
+    }
+
+    inline CutCoefficients designIIRLowpassHighOrderButterworthMethod (float frequency, double sampleRate, int order, float quality)
     {
         jassert (sampleRate > 0);
         jassert (frequency > 0 && frequency <= sampleRate * 0.5);
-        jassert (order > 0);
+        jassert (order > 0 && order <= CutFilterTable::maxOrder);
         jassert (quality > 0);
 
-        ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
-         
-        int n = order / 2;
-        double a = std::pow(quality * MathConstants<double>::sqrt2, 1.0 / static_cast<double> (n));
+        const auto& table = CutFilterTable::getInstance();
+        auto k = table.getPrewarpedFrequency (frequency, sampleRate);
+        auto a = getButterworthQualityScale (order, quality);
+
+        CutCoefficients sections;
 
         if (order % 2 == 1)
-        {
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeFirstOrderLowPass (sampleRate, frequency));
-
-            for (int i = 0; i < order / 2; ++i)
-            {
-                auto Q = a / (2.0 * std::cos ((i + 1.0) * MathConstants<double>::pi / order));
-                arrayFilters.add (*IIR::Coefficients<FloatType>::makeLowPass (sampleRate, frequency,
-                                                                              static_cast<FloatType> (Q)));
-            }
-        }
-        else
-        {
-            for (int i = 0; i < order / 2; ++i)
-            {
-                auto Q = a / (2.0 * std::cos ((2.0 * i + 1.0) * MathConstants<double>::pi / (order * 2.0)));
-                arrayFilters.add (*IIR::Coefficients<FloatType>::makeLowPass (sampleRate, frequency,
-                                                                              static_cast<FloatType> (Q)));
-            }
-        }
-
-        return arrayFilters;
+            sections.add (BiquadCoefficients::makePrewarpedFirstOrderLowPass (k));
+
+        for (int i = 0; i < order / 2; ++i)
+            sections.add (BiquadCoefficients::makePrewarpedLowPass (k, a / table.getSectionDivisor (order, i)));
+
+        return sections;
     }
 
-    template <typename FloatType>
-    ReferenceCountedArray<IIR::Coefficients<FloatType>>
-        designIIRHighpassHighOrderButterworthMethod (FloatType frequency, double sampleRate, int order, float quality)
+    inline CutCoefficients designIIRHighpassHighOrderButterworthMethod (float frequency, double sampleRate, int order, float quality)
     {
         jassert (sampleRate > 0);
         jassert (frequency > 0 && frequency <= sampleRate * 0.5);
-        jassert (order > 0);
+        jassert (order > 0 && order <= CutFilterTable::maxOrder);
         jassert (quality > 0);
-            
-        ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
-            
-        int n = order / 2;
-        double a = std::pow(quality * MathConstants<double>::sqrt2, 1.0 / static_cast<double> (n));
- 
+
+        const auto& table = CutFilterTable::getInstance();
+        auto k = table.getPrewarpedFrequency (frequency, sampleRate);
+        auto a = getButterworthQualityScale (order, quality);
+
+        CutCoefficients sections;
 
         if (order % 2 == 1)
-        {
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeFirstOrderHighPass (sampleRate, frequency));
-
-            for (int i = 0; i < order / 2; ++i)
-            {
-                auto Q = a / (2.0 * std::cos ((i + 1.0) * MathConstants<double>::pi / order));
-                arrayFilters.add (*IIR::Coefficients<FloatType>::makeHighPass (sampleRate, frequency,
-                                                                               static_cast<FloatType> (Q)));
-            }
-        }
-        else
-        {
-            for (int i = 0; i < order / 2; ++i)
-            {
-                auto Q = a / (2.0 * std::cos ((2.0 * i + 1.0) * MathConstants<double>::pi / (order * 2.0)));
-                arrayFilters.add (*IIR::Coefficients<FloatType>::makeHighPass (sampleRate, frequency,
-                                                                               static_cast<FloatType> (Q)));
-            }
-        }
-
-        return arrayFilters;
+            sections.add (BiquadCoefficients::makePrewarpedFirstOrderHighPass (k));
+
+        for (int i = 0; i < order / 2; ++i)
+            sections.add (BiquadCoefficients::makePrewarpedHighPass (k, a / table.getSectionDivisor (order, i)));
+
+        return sections;
     }
 
 }
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    LatestValueSlot.h
+    Created: 18 Oct 2026 10:58:20am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+// Single producer, single consumer hand off of the most recent value (a triple buffer).
+// push() and pull() are wait free and never allocate.  Values the consumer did not get to
+// before the next push are overwritten, which is what we want for parameters and coefficients:
+// only the newest set matters.
+template <typename T>
+struct LatestValueSlot
+{
+    static_assert (std::is_trivially_copyable<T>::value,
+                   "LatestValueSlot copies by value, T should be a small POD type");
+
+    // producer thread only
+    void push(const T& t)
+    {
+        buffers[writeIndex] = t;
+        auto previous = middle.exchange(writeIndex | freshFlag, std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    // consumer thread only.  returns false if nothing was pushed since the last pull.
+    bool pull(T& t)
+    {
+        if((middle.load(std::memory_order_relaxed) & freshFlag) == 0)
+            return false;
+
+        auto previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        t = buffers[readIndex];
+        return true;
+    }
+
+    bool hasNewValue() const
+    {
+        return (middle.load(std::memory_order_relaxed) & freshFlag) != 0;
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    std::array<T, 3> buffers {};
+    std::atomic<int> middle {1};
+    int writeIndex {0};
+    int readIndex {2};
+};
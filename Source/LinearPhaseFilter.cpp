@@ -0,0 +1,335 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilter.cpp
+    Created: 19 Oct 2026 1:48:55am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseFilter.h"
+
+LinearPhaseFilter::LinearPhaseFilter(const ParameterTable& parameterTable) : parameters {parameterTable}
+{
+}
+
+LinearPhaseFilter::~LinearPhaseFilter()
+{
+    release();
+}
+
+int LinearPhaseFilter::getKernelLength(double sampleRate)
+{
+    return juce::nextPowerOfTwo(juce::roundToInt(sampleRate / 6.0));
+}
+
+void LinearPhaseFilter::prepare(double newSampleRate, int newMaxBlockSize, int numChannels, bool linear)
+{
+    release();
+
+    sampleRate = newSampleRate;
+    maxBlockSize = newMaxBlockSize;
+    numPreparedChannels = numChannels;
+    kernelLength = getKernelLength(sampleRate);
+    crossfadeSamples = juce::roundToInt(sampleRate * crossfadeSeconds);
+    linked = numChannels > 2;
+
+    currentSlot = 0;
+    crossfading = false;
+    kernelReady = false;
+    redesignWanted = false;
+    startRequested = false;
+
+    if(linear)
+        activate();
+}
+
+void LinearPhaseFilter::activate()
+{
+    // not prepared yet, prepare does it then
+    if(kernelLength == 0)
+        return;
+
+    auto expected = static_cast<int>(inactive);
+    if(! activation.compare_exchange_strong(expected, activating))
+        return;
+
+    allocate();
+    activation.store(active, std::memory_order_release);
+}
+
+void LinearPhaseFilter::allocate()
+{
+    workerPool.emplace();
+
+    NonUniformConvolver::makeTransforms(partitionFFTs);
+    kernelFFT = std::make_unique<juce::dsp::FFT>(juce::findHighestSetBit(static_cast<juce::uint32>(kernelLength)));
+
+    auto length = static_cast<size_t>(kernelLength);
+    spectrum.assign(2 * length, 0.0f);
+    impulse.assign(length, 0.0f);
+    partitionBuffer.assign(4 * static_cast<size_t>(NonUniformConvolver::partitionSizes.back()), 0.0f);
+
+    // Blackman, centred on the middle of the kernel where the impulse peaks
+    window.resize(length);
+    for(size_t n = 0; n < length; ++n)
+    {
+        auto phase = juce::MathConstants<double>::twoPi * static_cast<double>(n) / static_cast<double>(length);
+        window[n] = static_cast<float>(0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase));
+    }
+
+    // a core left over for the audio thread
+    auto numWorkers = juce::jlimit(1, juce::jmax(1, juce::SystemStats::getNumCpus() - 1), (numPreparedChannels + 1) / 2);
+
+    for(int worker = 0; worker < numWorkers; ++worker)
+        convolutionWorkers.add(new ConvolutionWorkerPool());
+
+    for(int channel = 0; channel < numPreparedChannels; ++channel)
+    {
+        auto* convolver = convolvers.add(new NonUniformConvolver());
+        convolver->prepare(kernelLength, maxBlockSize, *convolutionWorkers[channel % numWorkers]);
+    }
+
+    for(auto& channelKernels : kernels)
+        for(auto& kernel : channelKernels)
+            kernel.allocate(kernelLength, maxBlockSize);
+
+    // straight into the playing slot, the convolvers run them from the first sample
+    makeKernels(static_cast<size_t>(currentSlot));
+}
+
+void LinearPhaseFilter::release()
+{
+    // a design or a partition still running would be working on what's about to be given back
+    if(workerPool.has_value())
+        (*workerPool)->waitUntilIdle(designer);
+
+    // the convolvers wait for their workers, and go before the kernels a partition may be reading
+    convolvers.clear();
+    convolutionWorkers.clear();
+    workerPool.reset();
+
+    kernels = {};
+    for(auto& transform : partitionFFTs)
+        transform.reset();
+    kernelFFT.reset();
+
+    for(auto* buffer : {&spectrum, &impulse, &window, &partitionBuffer})
+    {
+        buffer->clear();
+        buffer->shrink_to_fit();
+    }
+
+    activation = inactive;
+}
+
+int LinearPhaseFilter::getLatencySamples() const
+{
+    return kernelLength / 2;
+}
+
+int LinearPhaseFilter::getTailLengthSamples() const
+{
+    return kernelLength;
+}
+
+int LinearPhaseFilter::getNumLatePartitions() const
+{
+    int total = 0;
+
+    if(isActive())
+        for(auto* convolver : convolvers)
+            total += convolver->getNumLatePartitions();
+
+    return total;
+}
+
+int LinearPhaseFilter::getNumMissedPartitions() const
+{
+    int total = 0;
+
+    if(isActive())
+        for(auto* convolver : convolvers)
+            total += convolver->getNumMissedPartitions();
+
+    return total;
+}
+
+bool LinearPhaseFilter::readyToStart()
+{
+    if(nonRealtime)
+    {
+        // Offline nobody minds the wait, and the FIR path starts at the same sample every render.
+        // Switched on since prepare, the message thread may not have got round to activate, or be in
+        // the middle of it.
+        activate();
+        while(! isActive())
+            juce::Thread::sleep(1);
+
+        (*workerPool)->waitUntilIdle(designer);
+        for(auto* convolver : convolvers)
+            convolver->waitForWorker();
+
+        makeKernels(static_cast<size_t>(currentSlot));
+        kernelReady = false;
+        redesignWanted = false;
+
+        start();
+        return true;
+    }
+
+    // switched on since prepare, and the message thread hasn't got round to activate yet
+    if(! isActive())
+        return false;
+
+    // A design or a partition still with a worker is left over from before.  It has to be finished
+    // before its kernel can be dropped, or the convolver it's reading cleared.
+    if(! (*workerPool)->isIdle(designer))
+        return false;
+
+    for(auto* convolver : convolvers)
+        if(convolver->isWorkerBusy())
+            return false;
+
+    if(! startRequested || ! kernelReady.load(std::memory_order_acquire))
+    {
+        kernelReady = false;
+        redesignWanted = false;
+        startRequested = true;
+
+        requestDesign();
+        return false;
+    }
+
+    // straight in without a fade
+    currentSlot = 1 - currentSlot;
+    kernelReady = false;
+    start();
+
+    if(redesignWanted.exchange(false))
+        requestDesign();
+
+    return true;
+}
+
+void LinearPhaseFilter::requestDesign()
+{
+    if(! isActive())
+        return;
+
+    if(! nonRealtime)
+    {
+        (*workerPool)->submit(designer);
+        return;
+    }
+
+    // Offline the new kernel is ready, and starts to fade in, at the block that asked for it.  Only a
+    // design asked for before the host went offline could still be with the worker.
+    (*workerPool)->waitUntilIdle(designer);
+    design();
+}
+
+void LinearPhaseFilter::start()
+{
+    for(auto* convolver : convolvers)
+        convolver->reset();
+
+    // a fade the last run was in the middle of, its kernel was given back with the others
+    crossfading = false;
+    startRequested = false;
+}
+
+void LinearPhaseFilter::beginCrossfade()
+{
+    currentSlot = 1 - currentSlot;
+    crossfading = true;
+
+    for(auto* convolver : convolvers)
+        convolver->startCrossfade(crossfadeSamples);
+}
+
+bool LinearPhaseFilter::isCrossfading(int numChannels) const
+{
+    // every channel's fade ends at the same sample, but any of them can have a late partition still
+    // reading the old kernel
+    for(int channel = 0; channel < numChannels; ++channel)
+        if(convolvers[channel]->isCrossfading())
+            return true;
+
+    return false;
+}
+
+void LinearPhaseFilter::endCrossfade()
+{
+    crossfading = false;
+
+    // The job sets redesignWanted before it looks at kernelReady, and this clears kernelReady before
+    // it looks at redesignWanted, so between them one of the two always sees the other's request.
+    kernelReady = false;
+
+    if(redesignWanted.exchange(false))
+        requestDesign();
+}
+
+void LinearPhaseFilter::design()
+{
+    // the audio thread hasn't given the spare kernels back yet, it asks again when it does
+    redesignWanted = true;
+
+    if(kernelReady)
+        return;
+
+    if(! redesignWanted.exchange(false))
+        return;
+
+    makeKernels(static_cast<size_t>(1 - currentSlot));
+    kernelReady.store(true, std::memory_order_release);
+}
+
+void LinearPhaseFilter::makeKernels(size_t slot)
+{
+    // the chains at the rate the IIR path would run them, so the FIR has the response the curve shows
+    auto designSampleRate = sampleRate * (1 << static_cast<int>(parameters.getOversampling()));
+    auto mode = static_cast<ChannelMode>(parameters.getProcessingMode());
+
+    makeImpulse(Channel::Left, designSampleRate);
+    kernels[0][slot].set(impulse.data(), partitionFFTs, partitionBuffer.data());
+
+    if(mode == ChannelMode::Stereo || linked)
+    {
+        kernels[1][slot] = kernels[0][slot];
+    }
+    else
+    {
+        makeImpulse(Channel::Right, designSampleRate);
+        kernels[1][slot].set(impulse.data(), partitionFFTs, partitionBuffer.data());
+    }
+}
+
+void LinearPhaseFilter::makeImpulse(Channel channel, double designSampleRate)
+{
+    ChainHelpers::initializeFilters(chain, channel, parameters, 0.0f, false, designSampleRate);
+
+    // the chain's magnitude with no phase at all, at every bin up to Nyquist
+    auto numBins = kernelLength / 2 + 1;
+    auto binWidth = sampleRate / kernelLength;
+
+    for(int bin = 0; bin < numBins; ++bin)
+    {
+        spectrum[static_cast<size_t>(2 * bin)] = static_cast<float>(ChainHelpers::getMagnitudeForFrequency(chain, bin * binWidth));
+        spectrum[static_cast<size_t>(2 * bin + 1)] = 0.0f;
+    }
+
+    kernelFFT->performRealOnlyInverseTransform(spectrum.data());
+
+    // Zero phase peaks at the first sample and wraps round to the last.  Moving it to the middle makes
+    // it causal with a delay of half the kernel, and the window tapers the ends where it was cut.
+    auto half = kernelLength / 2;
+
+    for(int n = 0; n < kernelLength; ++n)
+    {
+        auto source = static_cast<size_t>((n + half) & (kernelLength - 1));
+        impulse[static_cast<size_t>(n)] = spectrum[source] * window[static_cast<size_t>(n)];
+    }
+}
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilter.h
+    Created: 19 Oct 2026 1:48:55am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <JuceHeader.h>
+#include "ChainHelpers.h"
+#include "CoefficientWorkerPool.h"
+#include "NonUniformConvolver.h"
+#include "ParameterTable.h"
+
+// The linear phase alternative to the IIR chains, for both channels.  A job on the CoefficientWorkerPool
+// samples the magnitude of the same chains the response curve draws, at every bin of a kernel length
+// inverse FFT, and turns it into a symmetric, windowed FIR, which a NonUniformConvolver per channel runs.
+// On a bus wider than stereo the channels are linked, every one of them runs the left channel's kernel.
+//
+// There are two kernels per channel.  The audio thread runs one, the job writes the other and then
+// hands it over through kernelReady.  The audio thread crossfades to it, and only gives the old one back
+// once the fade is done, so the job never writes a kernel that is playing.  Requests that come in
+// while a kernel is waiting or fading are remembered and designed when it's given back.
+//
+// The first kernels never fade in from silence.  activate designs them itself, and switching to the
+// FIR path waits for kernels made for the parameters as they are.  Rendering offline, every design
+// is made right where it's asked for instead of on the worker, so a render comes out the same every
+// time.
+//
+// None of it is allocated, and no thread is started, until linear phase is wanted.  prepare does it
+// when it already is, activate when it's switched on later, and until then readyToStart says no.
+// Each ConvolutionWorkerPool takes a pair of channels, up to one fewer than there are cores.
+class LinearPhaseFilter
+{
+public:
+    explicit LinearPhaseFilter(const ParameterTable& parameterTable);
+    ~LinearPhaseFilter();
+
+    // a power of two of about a sixth of a second, 8192 at 48 kHz, for about 6 Hz between bins
+    static int getKernelLength(double sampleRate);
+
+    // Message thread, while the audio thread is stopped.  With linear it allocates everything, so
+    // nothing after this does, and designs the first kernels from the current parameters before it
+    // returns.  Without, it gives back whatever the last run in linear phase had.  maxBlockSize sets
+    // how long the convolution workers get, see NonUniformConvolver.
+    void prepare(double sampleRate, int maxBlockSize, int numChannels, bool linear);
+
+    // Message thread, when linear phase is switched on, or the audio thread rendering offline from
+    // readyToStart.  Does what prepare would have with linear, while the audio thread plays on,
+    // unless that's been done already.
+    void activate();
+
+    // half the kernel, for the linear phase, the convolution itself adds none
+    int getLatencySamples() const;
+    int getTailLengthSamples() const;
+
+    // every channel's NonUniformConvolver::getNumLatePartitions and getNumMissedPartitions, since prepare
+    int getNumLatePartitions() const;
+    int getNumMissedPartitions() const;
+
+    // Audio thread, every block, with the host's AudioProcessor::isNonRealtime.
+    void setNonRealtime(bool isNonRealtime)     { nonRealtime = isNonRealtime; }
+
+    // Audio thread, before switching to the FIR path, every block until it's true.  True once there
+    // are kernels for the parameters as they are, which offline is straight away, and otherwise takes
+    // the worker a few milliseconds, after activate has been.  The convolvers start clean from there.
+    // cancelStart for a switch that didn't happen after all.
+    bool readyToStart();
+    void cancelStart()                          { startRequested = false; }
+
+    // Audio thread.  Designs new kernels from the current parameters, without waiting, or offline
+    // before it returns.  Nothing to do before activate.
+    void requestDesign();
+
+    template <typename SampleType>
+    void process(SampleType* const* channels, int numChannels, int numSamples)
+    {
+        jassert(isActive() && numChannels <= convolvers.size());
+
+        if(! crossfading && kernelReady.load(std::memory_order_acquire))
+            beginCrossfade();
+
+        auto previousSlot = 1 - currentSlot;
+
+        for(int channel = 0; channel < numChannels; ++channel)
+        {
+            // everything past the left runs the right channel's kernels, the left's again when linked
+            auto& channelKernels = kernels[channel == 0 ? 0 : 1];
+            convolvers[channel]->process(channels[channel], numSamples, &channelKernels[static_cast<size_t>(currentSlot)],
+                                         crossfading ? &channelKernels[static_cast<size_t>(previousSlot)] : nullptr);
+        }
+
+        if(crossfading && ! isCrossfading(numChannels))
+            endCrossfade();
+    }
+
+private:
+    // left and right, there are only ever two sets of parameters
+    static constexpr size_t numKernelChannels = 2;
+
+    // about as long as the IIR bands take to ramp to new settings
+    static constexpr double crossfadeSeconds = 0.02;
+
+    // Whoever gets it from inactive to activating does the allocating, the message thread when linear
+    // phase is switched on, or the audio thread rendering offline if it gets there first.
+    enum Activation
+    {
+        inactive,
+        activating,
+        active
+    };
+
+    struct Designer : CoefficientWorkerPool::Job
+    {
+        explicit Designer(LinearPhaseFilter& owner) : filter {owner} {}
+        void run() override { filter.design(); }
+
+        LinearPhaseFilter& filter;
+    };
+
+    // activate's and prepare's
+    void allocate();
+    void release();
+    bool isActive() const   { return activation.load(std::memory_order_acquire) == active; }
+
+    // worker thread, or the audio thread offline
+    void design();
+    void makeKernels(size_t slot);
+    void makeImpulse(Channel channel, double designSampleRate);
+
+    // audio thread
+    void start();
+    void beginCrossfade();
+    void endCrossfade();
+    bool isCrossfading(int numChannels) const;
+
+    const ParameterTable& parameters;
+
+    double sampleRate {44100.0};
+    int numPreparedChannels {0};
+    int maxBlockSize {0};
+    int kernelLength {0};
+    int crossfadeSamples {0};
+
+    // the designer's, the convolvers have their own
+    NonUniformConvolver::Transforms partitionFFTs;
+    std::unique_ptr<juce::dsp::FFT> kernelFFT;
+
+    // the workers before the convolvers, which hand them partitions up to the end
+    juce::OwnedArray<ConvolutionWorkerPool> convolutionWorkers;
+    juce::OwnedArray<NonUniformConvolver> convolvers;
+    std::array<std::array<NonUniformConvolver::Kernel, 2>, numKernelChannels> kernels;
+
+    // more than two channels, so the right kernel is the left one whatever the mode
+    bool linked {false};
+
+    // the designer's working space
+    ChainHelpers::MonoFilterChain chain;
+    std::vector<float> spectrum, impulse, window, partitionBuffer;
+
+    // the slot the audio thread plays, the job writes the other one
+    int currentSlot {0};
+    bool crossfading {false};
+
+    bool nonRealtime {false};
+    bool startRequested {false};
+
+    std::atomic<bool> kernelReady {false};
+    std::atomic<bool> redesignWanted {false};
+    std::atomic<int> activation {inactive};
+
+    // the designer's, only held on to while active
+    std::optional<juce::SharedResourcePointer<CoefficientWorkerPool>> workerPool;
+    Designer designer {*this};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LinearPhaseFilter)
+};
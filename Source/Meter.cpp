@@ -77,11 +77,11 @@ juce::Rectangle<int> Meter::getMeterBounds()
     return getBounds().withTrimmedTop(LABEL_SIZE);
 }
 
-void Meter::update(float dbLevelPeak, float dbLevelRMS)
+void Meter::update(float dbLevelPeak, float dbLevelRMS, float dbLevelTruePeak)
 {
     peakDb = dbLevelPeak;
     averageDb.add(dbLevelRMS);
-    decayingValueHolder.updateHeldValue(peakDb);
+    decayingValueHolder.updateHeldValue(dbLevelTruePeak);
     repaint();
 }
 
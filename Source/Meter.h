@@ -35,7 +35,8 @@ public:
 
     void paint (juce::Graphics&) override;
     
-    void update(float dbLevelPeak, float dbLevelRMS);
+    // the held value and its over indicator follow the true peak, so inter-sample overs show
+    void update(float dbLevelPeak, float dbLevelRMS, float dbLevelTruePeak);
     
     juce::Rectangle<int> getMeterBounds();
     
@@ -14,4 +14,5 @@
 struct MeterValues
 {
     Decibel<float> leftPeakDb, rightPeakDb, leftRmsDb, rightRmsDb;
+    Decibel<float> leftTruePeakDb, rightTruePeakDb;     // between the samples, 4x oversampled
 };
@@ -83,14 +83,14 @@ float qFromBandWidth(float BW)
 
 
 
-std::tuple<float, float, float, bool> getParameterTuple(ChainPosition chainPos, Channel channel, juce::AudioProcessorValueTreeState& apvts)
+std::tuple<float, float, float, bool> getParameterTuple(ChainPosition chainPos, Channel channel, const ParameterTable& parameters)
 {
     float freq, gainOrSlope, Q;
     bool bypassed;
     
     if(chainPos == ChainPosition::LowCut || chainPos == ChainPosition::HighCut)
     {
-        auto cutParams = ChainHelpers::getFilterParams<HighCutLowCutParameters>(chainPos, channel, 0.0, apvts);
+        auto cutParams = ChainHelpers::getFilterParams<HighCutLowCutParameters>(chainPos, channel, 0.0, parameters);
         freq = cutParams.frequency;
         gainOrSlope = 30 - cutParams.order * 6.f;
         Q = cutParams.quality;
@@ -98,7 +98,7 @@ std::tuple<float, float, float, bool> getParameterTuple(ChainPosition chainPos,
     }
     else
     {
-        auto params = ChainHelpers::getFilterParams<FilterParameters>(chainPos, channel, 0.0, apvts);
+        auto params = ChainHelpers::getFilterParams<FilterParameters>(chainPos, channel, 0.0, parameters);
         freq = params.frequency;
         gainOrSlope = params.gain.getDb();
         Q = params.quality;
@@ -252,7 +252,7 @@ void NodeController::updateNode(AnalyzerNode& node, juce::Rectangle<float> bBox)
     auto chainPos = node.getChainPosition();
     auto channel = node.getChannel();
     
-    auto [freq, gainOrSlope, Q, bypassed] = getParameterTuple(chainPos, channel, apvts);
+    auto [freq, gainOrSlope, Q, bypassed] = getParameterTuple(chainPos, channel, parameters);
     
     if(bypassed)
     {
@@ -273,7 +273,7 @@ void NodeController::updateBand(AnalyzerBand& band, juce::Rectangle<float> bBox)
     auto chainPos = band.getChainPosition();
     auto channel = band.getChannel();
     
-    auto [freq, gainOrSlope, Q, bypassed] = getParameterTuple(chainPos, channel, apvts);
+    auto [freq, gainOrSlope, Q, bypassed] = getParameterTuple(chainPos, channel, parameters);
     
     if(bypassed)
     {
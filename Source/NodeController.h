@@ -13,6 +13,7 @@
 #include "AnalyzerWidgets.h"
 #include "AllParamsListener.h"
 #include "ParameterAttachment.h"
+#include "ParameterTable.h"
 
 #define MOUSE_DEBUG false
 
@@ -158,5 +159,6 @@ private:
     juce::ListenerList<Listener> nodeListeners;
     
     juce::AudioProcessorValueTreeState& apvts;
+    ParameterTable parameters {apvts};
 };
 
@@ -0,0 +1,369 @@
+/*
+  ==============================================================================
+
+    NonUniformConvolver.cpp
+    Created: 19 Oct 2026 3:06:14am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "NonUniformConvolver.h"
+
+ConvolutionWorkerPool::ConvolutionWorkerPool() : CoefficientWorkerPool {"Convolution Worker Thread"}
+{
+   #if JUCE_VERSION >= 0x70006
+    if(! startRealtimeThread(juce::Thread::RealtimeOptions {}))
+        startThread(juce::Thread::Priority::highest);
+   #else
+    startThread(realtimeAudioPriority);
+   #endif
+}
+
+int NonUniformConvolver::getLag(size_t stage, int maxBlockSize)
+{
+    if(stage == 0)
+        return 0;
+
+    auto size = partitionSizes[stage];
+    return juce::jmax(2, (maxBlockSize + size - 1) / size);
+}
+
+int NonUniformConvolver::getNumPartitions(size_t stage, int kernelLength, int maxBlockSize)
+{
+    auto end = stage + 1 < numStages ? getStageStart(stage + 1, maxBlockSize) : kernelLength;
+    auto length = juce::jmin(end, kernelLength) - getStageStart(stage, maxBlockSize);
+
+    jassert(length <= 0 || length % partitionSizes[stage] == 0);
+    return juce::jmax(0, length / partitionSizes[stage]);
+}
+
+void NonUniformConvolver::makeTransforms(Transforms& transforms)
+{
+    for(size_t stage = 0; stage < numStages; ++stage)
+    {
+        auto order = juce::findHighestSetBit(static_cast<juce::uint32>(2 * partitionSizes[stage]));
+        transforms[stage] = std::make_unique<juce::dsp::FFT>(order);
+    }
+}
+
+void NonUniformConvolver::Kernel::allocate(int newLength, int newMaxBlockSize)
+{
+    length = newLength;
+    maxBlockSize = newMaxBlockSize;
+    head.assign(static_cast<size_t>(headLength), 0.0f);
+
+    for(size_t stage = 0; stage < numStages; ++stage)
+        stages[stage].allocate(partitionSizes[stage], getNumPartitions(stage, length, maxBlockSize));
+
+    clear();
+}
+
+void NonUniformConvolver::Kernel::set(const float* impulse, const Transforms& transforms, float* buffer)
+{
+    for(int tap = 0; tap < headLength; ++tap)
+        head[static_cast<size_t>(headLength - 1 - tap)] = impulse[tap];
+
+    for(size_t stage = 0; stage < numStages; ++stage)
+    {
+        if(stages[stage].numPartitions > 0)
+            stages[stage].set(impulse + getStageStart(stage, maxBlockSize), *transforms[stage], buffer);
+    }
+
+    empty = false;
+}
+
+NonUniformConvolver::~NonUniformConvolver()
+{
+    waitForWorker();
+}
+
+void NonUniformConvolver::prepare(int newKernelLength, int newMaxBlockSize, ConvolutionWorkerPool& worker)
+{
+    jassert(juce::isPowerOfTwo(newKernelLength) && newKernelLength > headLength && newMaxBlockSize > 0);
+
+    // a partition still with the worker would be working on what's about to be replaced
+    waitForWorker();
+
+    workerPool = &worker;
+    kernelLength = newKernelLength;
+    maxBlockSize = newMaxBlockSize;
+
+    for(size_t index = 0; index < numStages; ++index)
+    {
+        auto& stage = stages[index];
+        auto size = static_cast<size_t>(partitionSizes[index]);
+
+        stage.partitionSize = partitionSizes[index];
+        stage.lag = getLag(index, maxBlockSize);
+        stage.input.assign(2 * size, 0.0f);
+        stage.output.assign(size, 0.0f);
+        stage.jobs.clear();
+
+        // A partition with the worker reads its own slot and the older ones while up to lag - 1 newer
+        // ones are pushed, lag spare slots leave one over.
+        stage.convolver.prepare(stage.partitionSize, getNumPartitions(index, kernelLength, maxBlockSize),
+                                index == 0 ? 0 : stage.lag);
+
+        if(index == 0)
+        {
+            stage.scratch.prepare(stage.partitionSize);
+            continue;
+        }
+
+        for(int i = 0; i < stage.lag; ++i)
+        {
+            auto* job = stage.jobs.add(new Job());
+            job->convolver = &stage.convolver;
+            job->scratch.prepare(stage.partitionSize);
+            job->result.assign(size, 0.0f);
+        }
+    }
+
+    history.assign(2 * static_cast<size_t>(headLength), 0.0f);
+    mixed.assign(static_cast<size_t>(headLength), 0.0f);
+
+    latePartitions = 0;
+    missedPartitions = 0;
+    reset();
+}
+
+void NonUniformConvolver::reset()
+{
+    jassert(! isWorkerBusy());
+
+    for(auto& stage : stages)
+    {
+        for(auto* job : stage.jobs)
+            job->due = false;
+
+        stage.convolver.reset();
+        stage.nextJob = 0;
+
+        std::fill(stage.input.begin(), stage.input.end(), 0.0f);
+        std::fill(stage.output.begin(), stage.output.end(), 0.0f);
+    }
+
+    std::fill(history.begin(), history.end(), 0.0f);
+    historyIndex = 0;
+
+    time = 0;
+    block = 0;
+    fadeStart = fadeEnd = 0;
+}
+
+void NonUniformConvolver::startCrossfade(int numSamples)
+{
+    fadeStart = time;
+
+    for(size_t index = 0; index < numStages; ++index)
+    {
+        if(! isActive(index))
+            continue;
+
+        // the partition that ended last plays lag partitions after that, and for one partition
+        auto& stage = stages[index];
+        auto lastEnd = time & ~static_cast<juce::int64>(stage.partitionSize - 1);
+        fadeStart = juce::jmax(fadeStart, lastEnd + (stage.lag + 1) * stage.partitionSize);
+    }
+
+    fadeEnd = fadeStart + juce::jmax(1, numSamples);
+}
+
+bool NonUniformConvolver::isWorkerBusy() const
+{
+    for(auto& stage : stages)
+        for(auto* job : stage.jobs)
+            if(job->isBusy())
+                return true;
+
+    return false;
+}
+
+void NonUniformConvolver::waitForWorker()
+{
+    // never prepared, so never handed anything
+    if(workerPool == nullptr)
+        return;
+
+    for(auto& stage : stages)
+        for(auto* job : stage.jobs)
+            workerPool->waitUntilIdle(*job);
+}
+
+bool NonUniformConvolver::isCrossfading() const
+{
+    if(time < fadeEnd)
+        return true;
+
+    for(auto& stage : stages)
+        for(auto* job : stage.jobs)
+            if(job->previous != nullptr && job->isBusy())
+                return true;
+
+    return false;
+}
+
+PartitionedConvolver::Fade NonUniformConvolver::getFade(juce::int64 playTime) const
+{
+    if(playTime >= fadeEnd)
+        return {};
+
+    auto step = 1.0f / static_cast<float>(fadeEnd - fadeStart);
+    return {static_cast<float>(playTime - fadeStart) * step, step};
+}
+
+float NonUniformConvolver::applyHead(const float* recent, const float* taps)
+{
+    float sum = 0.0f;
+
+    for(int tap = 0; tap < headLength; ++tap)
+        sum += recent[tap] * taps[tap];
+
+    return sum;
+}
+
+void NonUniformConvolver::processChunk(float* samples, int numSamples, const Kernel* kernel, const Kernel* previous)
+{
+    auto fade = getFade(time);
+    const auto* taps = kernel != nullptr ? kernel->head.data() : nullptr;
+    const auto* previousTaps = previous != nullptr ? previous->head.data() : nullptr;
+    auto* out = mixed.data();
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        history[static_cast<size_t>(historyIndex)] = samples[i];
+        history[static_cast<size_t>(historyIndex + headLength)] = samples[i];
+        historyIndex = (historyIndex + 1) & (headLength - 1);
+
+        const auto* recent = history.data() + historyIndex;
+        auto value = taps != nullptr ? applyHead(recent, taps) : 0.0f;
+
+        if(! fade.isDone())
+        {
+            auto old = previousTaps != nullptr ? applyHead(recent, previousTaps) : 0.0f;
+            value = old + juce::jlimit(0.0f, 1.0f, fade.start + static_cast<float>(i) * fade.step) * (value - old);
+        }
+
+        out[i] = value;
+    }
+
+    for(size_t index = 0; index < numStages; ++index)
+    {
+        if(! isActive(index))
+            continue;
+
+        auto& stage = stages[index];
+        auto offset = static_cast<int>(time & (stage.partitionSize - 1));
+
+        std::copy(samples, samples + numSamples, stage.input.data() + stage.partitionSize + offset);
+
+        const auto* delayed = stage.output.data() + offset;
+        for(int i = 0; i < numSamples; ++i)
+            out[i] += delayed[i];
+    }
+
+    std::copy(out, out + numSamples, samples);
+    time += numSamples;
+
+    if((time & (headLength - 1)) == 0)
+        endPartition(kernel, previous);
+}
+
+void NonUniformConvolver::endPartition(const Kernel* kernel, const Kernel* previous)
+{
+    for(size_t index = 0; index < numStages; ++index)
+    {
+        auto& stage = stages[index];
+
+        if(! isActive(index) || (time & (stage.partitionSize - 1)) != 0)
+            continue;
+
+        if(index == 0)
+        {
+            // plays from now, for the partition that starts here
+            auto slot = stage.convolver.pushInput(stage.input.data());
+            stage.convolver.processPartition(slot, stage.output.data(),
+                                             kernel != nullptr ? &kernel->stages[index] : nullptr,
+                                             previous != nullptr ? &previous->stages[index] : nullptr, getFade(time),
+                                             stage.scratch);
+            std::copy(stage.input.begin() + stage.partitionSize, stage.input.end(), stage.input.begin());
+        }
+        else
+        {
+            handOver(index, kernel, previous);
+        }
+    }
+}
+
+void NonUniformConvolver::handOver(size_t index, const Kernel* kernel, const Kernel* previous)
+{
+    auto& stage = stages[index];
+    auto& job = *stage.jobs.getUnchecked(stage.nextJob);
+    stage.nextJob = (stage.nextJob + 1) % stage.lag;
+
+    // The partition handed over lag partitions ago plays next.  Once it's finished nothing reads its
+    // slot or its job any more.
+    finish(stage, job);
+
+    auto slot = stage.convolver.pushInput(stage.input.data());
+    std::copy(stage.input.begin() + stage.partitionSize, stage.input.end(), stage.input.begin());
+
+    // and this one lag partitions from now
+    job.slot = slot;
+    job.kernel = kernel != nullptr ? &kernel->stages[index] : nullptr;
+    job.previous = previous != nullptr ? &previous->stages[index] : nullptr;
+    job.fade = getFade(time + stage.lag * stage.partitionSize);
+    job.due = true;
+    job.handedOverIn = block;
+
+    job.state.store(pending, std::memory_order_release);
+    workerPool->submit(job);
+}
+
+void NonUniformConvolver::finish(Stage& stage, Job& job)
+{
+    if(! job.due)
+    {
+        std::fill(stage.output.begin(), stage.output.end(), 0.0f);
+        return;
+    }
+
+    job.due = false;
+
+    if(job.state.load(std::memory_order_acquire) != done)
+    {
+        ++latePartitions;
+
+        // the worker had no time for it at all, the block was longer than prepare was told
+        if(job.handedOverIn == block)
+            ++missedPartitions;
+
+        // Not started, it's done here.  Started, the worker is part way through one partition at real
+        // time priority, which is sooner than doing it all again here.
+        if(job.claim())
+            job.compute();
+        else
+            while(job.state.load(std::memory_order_acquire) != done) {}
+    }
+
+    std::copy(job.result.begin(), job.result.end(), stage.output.begin());
+}
+
+bool NonUniformConvolver::Job::claim()
+{
+    auto expected = static_cast<int>(pending);
+    return state.compare_exchange_strong(expected, running, std::memory_order_acquire);
+}
+
+bool NonUniformConvolver::Job::isBusy() const
+{
+    auto current = state.load(std::memory_order_acquire);
+    return current == pending || current == running;
+}
+
+void NonUniformConvolver::Job::compute()
+{
+    convolver->processPartition(slot, result.data(), kernel, previous, fade, scratch);
+    state.store(done, std::memory_order_release);
+}
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+    NonUniformConvolver.h
+    Created: 19 Oct 2026 3:06:14am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <JuceHeader.h>
+#include "CoefficientWorkerPool.h"
+#include "PartitionedConvolver.h"
+
+// The pool NonUniformConvolver hands its later stages to.  Its owner keeps as many as the load needs,
+// apart from the shared CoefficientWorkerPool so a partition never waits behind a kernel design, and
+// at real time priority, so it isn't left waiting behind the host's other threads either.
+struct ConvolutionWorkerPool : CoefficientWorkerPool
+{
+    ConvolutionWorkerPool();
+};
+
+// Convolution of one channel with a long FIR, with no latency of its own.  The first headLength taps
+// are applied directly, sample by sample, and the rest of the kernel is split into stages, each a
+// PartitionedConvolver with partitions growing along the kernel (Gardner's non-uniform partitioning).
+//
+// A stage's output comes some time after its input, and the stage starts just that far into the kernel,
+// so what it adds arrives when it's due.  The first stage runs on the audio thread and has its output a
+// partition after the input, so it starts a partition in.  The later ones are handed to the
+// ConvolutionWorkerPool and have getLag partitions' time to come back, at least two and at least the
+// largest block, so a partition is never due in the same block it was handed over in and the worker
+// always has a block's time.  Each starts one partition more than that in.
+//
+// Every partition is heard.  One the worker hasn't started on when it's due, the audio thread works
+// out itself, and one the worker is still in the middle of, it waits for.  Either is a late
+// partition.  A late one that was due in the block it was handed over in, which only a block longer
+// than prepare was told of makes happen, is a missed one too.
+class NonUniformConvolver
+{
+public:
+    static constexpr size_t numStages = 3;
+    static constexpr std::array<int, numStages> partitionSizes {64, 256, 1024};
+    static constexpr int headLength = partitionSizes[0];
+
+    // How many partitions after it's handed over each stage's partition is due, where the stage starts
+    // in the kernel for that, and how many partitions of it a kernel of kernelLength has.
+    static int getLag(size_t stage, int maxBlockSize);
+    static int getStageStart(size_t stage, int maxBlockSize)   { return (getLag(stage, maxBlockSize) + 1) * partitionSizes[stage]; }
+    static int getNumPartitions(size_t stage, int kernelLength, int maxBlockSize);
+
+    // an FFT for each stage's partition size, for making kernels
+    using Transforms = std::array<std::unique_ptr<juce::dsp::FFT>, numStages>;
+    static void makeTransforms(Transforms& transforms);
+
+    // A kernel in the form the convolver runs it, made off the audio thread by Kernel::set.
+    struct Kernel
+    {
+        // message thread, for a convolver prepared with the same length and block size
+        void allocate(int newLength, int newMaxBlockSize);
+
+        // Splits up and transforms the first length samples of impulse.  buffer is
+        // 4 * partitionSizes.back() floats of scratch.
+        void set(const float* impulse, const Transforms& transforms, float* buffer);
+
+        // leaves it empty, a convolver treats that as a kernel of zeros
+        void clear()    { empty = true; }
+
+        std::vector<float> head;    // reversed, so it lines up with the input, oldest first
+        std::array<PartitionedConvolver::Kernel, numStages> stages;
+        int length {0};
+        int maxBlockSize {0};
+        bool empty {true};
+    };
+
+    NonUniformConvolver() = default;
+    ~NonUniformConvolver();
+
+    // Message thread.  kernelLength is a power of two, and the kernels passed to process have to be
+    // allocated for it and maxBlockSize.  The later stages go to worker, which has to outlive the
+    // convolver.
+    void prepare(int newKernelLength, int newMaxBlockSize, ConvolutionWorkerPool& worker);
+
+    // Audio thread, doesn't allocate or wait.  Only once isWorkerBusy is false, a partition still with
+    // the worker would be reading what this clears.
+    void reset();
+
+    // Whether the worker still has a partition of this one's, queued or running.
+    bool isWorkerBusy() const;
+
+    // Blocks until it hasn't.  Off the audio thread, or on it rendering offline.
+    void waitForWorker();
+
+    // Fades from the kernel passed as previous to the one passed as kernel over numSamples.  What the
+    // stages have already worked out with the old kernel alone has to play first, so the fade starts
+    // once it has, up to a stage's lag and one more of its partitions from now.
+    void startCrossfade(int numSamples);
+
+    // Until the fade is done, and no late partition could still be reading the old kernel.
+    bool isCrossfading() const;
+
+    // Late and missed partitions, see above, since prepare.  Any thread.
+    int getNumLatePartitions() const        { return latePartitions.load(std::memory_order_relaxed); }
+    int getNumMissedPartitions() const      { return missedPartitions.load(std::memory_order_relaxed); }
+
+    // Replaces the samples with the convolved ones.  A kernel that is null or empty counts as
+    // silence, so a crossfade from one fades in.
+    template <typename SampleType>
+    void process(SampleType* samples, int numSamples, const Kernel* kernel, const Kernel* previous)
+    {
+        if(! isUsable(kernel))
+            kernel = nullptr;
+        if(! isUsable(previous))
+            previous = nullptr;
+
+        ++block;
+        std::array<float, headLength> chunk;
+
+        while(numSamples > 0)
+        {
+            // every stage's partitions are whole numbers of the head's, so no chunk crosses the end of one
+            auto count = juce::jmin(numSamples, headLength - static_cast<int>(time & (headLength - 1)));
+
+            for(int i = 0; i < count; ++i)
+                chunk[static_cast<size_t>(i)] = static_cast<float>(samples[i]);
+
+            processChunk(chunk.data(), count, kernel, previous);
+
+            for(int i = 0; i < count; ++i)
+                samples[i] = static_cast<SampleType>(chunk[static_cast<size_t>(i)]);
+
+            samples += count;
+            numSamples -= count;
+        }
+    }
+
+private:
+    enum JobState
+    {
+        idle,
+        pending,
+        running,
+        done
+    };
+
+    // One partition of a later stage, handed to the worker.
+    struct Job : CoefficientWorkerPool::Job
+    {
+        // whoever gets it from pending to running does the partition
+        bool claim();
+        void compute();
+
+        void run() override
+        {
+            if(claim())
+                compute();
+        }
+
+        // pending or running
+        bool isBusy() const;
+
+        const PartitionedConvolver* convolver {nullptr};
+        PartitionedConvolver::Scratch scratch;
+        std::vector<float> result;
+
+        // what the job works with, set by the audio thread before it goes to pending
+        int slot {0};
+        const PartitionedConvolver::Kernel* kernel {nullptr};
+        const PartitionedConvolver::Kernel* previous {nullptr};
+        PartitionedConvolver::Fade fade;
+
+        // handed over and not played yet, and the process call it was handed over in, only the audio
+        // thread looks at them
+        bool due {false};
+        juce::int64 handedOverIn {0};
+
+        std::atomic<int> state {idle};
+    };
+
+    // One stage, its input and output.  A later stage's partitions are due lag partitions after
+    // they're handed over, so lag jobs take turns, the one due now is handed the next partition.
+    struct Stage
+    {
+        PartitionedConvolver convolver;
+        int partitionSize {0};
+        int lag {0};
+
+        // the last two input partitions, the older first, and what plays now
+        std::vector<float> input, output;
+
+        // the first stage's, it does its partitions on the audio thread
+        PartitionedConvolver::Scratch scratch;
+
+        juce::OwnedArray<Job> jobs;
+        int nextJob {0};
+    };
+
+    bool isUsable(const Kernel* kernel) const
+    {
+        return kernel != nullptr && ! kernel->empty && kernel->length == kernelLength && kernel->maxBlockSize == maxBlockSize;
+    }
+
+    bool isActive(size_t stage) const   { return stages[stage].convolver.getNumPartitions() > 0; }
+
+    void processChunk(float* samples, int numSamples, const Kernel* kernel, const Kernel* previous);
+
+    // at the end of every head partition, runs or hands over the stages whose partitions end there too
+    void endPartition(const Kernel* kernel, const Kernel* previous);
+    void handOver(size_t stage, const Kernel* kernel, const Kernel* previous);
+
+    // puts the job's partition in the stage's output, doing it here if the worker hasn't started on it
+    // and waiting if the worker is still in the middle of it
+    void finish(Stage& stage, Job& job);
+
+    // how far the fade has got at playTime
+    PartitionedConvolver::Fade getFade(juce::int64 playTime) const;
+
+    static float applyHead(const float* recent, const float* taps);
+
+    int kernelLength {0};
+    int maxBlockSize {0};
+
+    std::array<Stage, numStages> stages;
+
+    // the last headLength samples twice over, so they're always in one piece starting at historyIndex
+    std::vector<float> history, mixed;
+    int historyIndex {0};
+
+    juce::int64 time {0};
+    juce::int64 block {0};
+    juce::int64 fadeStart {0};
+    juce::int64 fadeEnd {0};
+
+    std::atomic<int> latePartitions {0};
+    std::atomic<int> missedPartitions {0};
+
+    ConvolutionWorkerPool* workerPool {nullptr};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NonUniformConvolver)
+};
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    ParameterTable.cpp
+    Created: 18 Oct 2026 9:05:47pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "ParameterTable.h"
+#include "GlobalParameters.h"
+#include "AnalyzerProperties.h"
+
+namespace
+{
+    std::atomic<float>* getRawValue(juce::AudioProcessorValueTreeState& apvts, const juce::String& name)
+    {
+        auto* value = apvts.getRawParameterValue(name);
+        jassert(value != nullptr);  // the layout and the names have drifted apart
+        return value;
+    }
+}
+
+ParameterTable::ParameterTable(juce::AudioProcessorValueTreeState& apvts)
+{
+    for(auto channel : {Channel::Left, Channel::Right})
+    {
+        for(size_t position = 0; position < numChainPositions; ++position)
+        {
+            auto chainPos = static_cast<ChainPosition>(position);
+            auto isCut = chainPos == ChainPosition::LowCut || chainPos == ChainPosition::HighCut;
+
+            filterValues[getIndex(channel, chainPos, Field::Bypass)] = getRawValue(apvts, createBypassParamString(channel, chainPos));
+            filterValues[getIndex(channel, chainPos, Field::Frequency)] = getRawValue(apvts, createFreqParamString(channel, chainPos));
+            filterValues[getIndex(channel, chainPos, Field::Quality)] = getRawValue(apvts, createQParamString(channel, chainPos));
+            filterValues[getIndex(channel, chainPos, Field::GainOrSlope)] =
+                getRawValue(apvts, isCut ? createSlopeParamString(channel, chainPos) : createGainParamString(channel, chainPos));
+        }
+    }
+
+    using namespace AnalyzerProperties;
+
+    processingMode = getRawValue(apvts, GlobalParameters::processingModeName);
+    inTrim = getRawValue(apvts, GlobalParameters::inTrimName);
+    outTrim = getRawValue(apvts, GlobalParameters::outTrimName);
+    oversampling = getRawValue(apvts, GlobalParameters::oversamplingName);
+    filterDesign = getRawValue(apvts, GlobalParameters::filterDesignName);
+    phaseMode = getRawValue(apvts, GlobalParameters::phaseModeName);
+    analyzerEnabled = getRawValue(apvts, getAnalyzerParamName(ParamNames::EnableAnalyzer));
+    analyzerMode = getRawValue(apvts, getAnalyzerParamName(ParamNames::AnalyzerProcessingMode));
+}
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    ParameterTable.h
+    Created: 18 Oct 2026 9:05:47pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <JuceHeader.h>
+#include "ParameterHelpers.h"
+
+// The raw values behind every parameter the audio thread reads, looked up by name once when the
+// processor is built.  Reading one is then an index and an atomic load, where going through the
+// apvts each block meant building the name as a juce::String and hashing it.
+struct ParameterTable
+{
+    // a cut filter's slope sits where a parametric band's gain does
+    enum class Field
+    {
+        Bypass,
+        Frequency,
+        Quality,
+        GainOrSlope
+    };
+
+    explicit ParameterTable(juce::AudioProcessorValueTreeState& apvts);
+
+    float get(Channel channel, ChainPosition chainPos, Field field) const
+    {
+        return filterValues[getIndex(channel, chainPos, field)]->load();
+    }
+
+    float getProcessingMode() const     { return processingMode->load(); }
+    float getInTrim() const             { return inTrim->load(); }
+    float getOutTrim() const            { return outTrim->load(); }
+    float getOversampling() const       { return oversampling->load(); }
+    float getFilterDesign() const       { return filterDesign->load(); }
+    float getPhaseMode() const          { return phaseMode->load(); }
+    float getAnalyzerEnabled() const    { return analyzerEnabled->load(); }
+    float getAnalyzerMode() const       { return analyzerMode->load(); }
+
+private:
+    static constexpr size_t numChannels = 2;
+    static constexpr size_t numChainPositions = 8;
+    static constexpr size_t numFields = 4;
+
+    static size_t getIndex(Channel channel, ChainPosition chainPos, Field field)
+    {
+        return (static_cast<size_t>(channel) * numChainPositions + static_cast<size_t>(chainPos)) * numFields
+               + static_cast<size_t>(field);
+    }
+
+    std::array<std::atomic<float>*, numChannels * numChainPositions * numFields> filterValues {};
+
+    std::atomic<float>* processingMode {nullptr};
+    std::atomic<float>* inTrim {nullptr};
+    std::atomic<float>* outTrim {nullptr};
+    std::atomic<float>* oversampling {nullptr};
+    std::atomic<float>* filterDesign {nullptr};
+    std::atomic<float>* phaseMode {nullptr};
+    std::atomic<float>* analyzerEnabled {nullptr};
+    std::atomic<float>* analyzerMode {nullptr};
+};
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    PartitionedConvolver.cpp
+    Created: 19 Oct 2026 1:12:37am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "PartitionedConvolver.h"
+
+void PartitionedConvolver::Kernel::allocate(int newPartitionSize, int newNumPartitions)
+{
+    partitionSize = newPartitionSize;
+    numPartitions = newNumPartitions;
+
+    // one more bin than samples per partition, for Nyquist
+    auto size = static_cast<size_t>(numPartitions * (partitionSize + 1));
+    real.assign(size, 0.0f);
+    imag.assign(size, 0.0f);
+}
+
+void PartitionedConvolver::Kernel::set(const float* impulse, const juce::dsp::FFT& fft, float* buffer)
+{
+    jassert(fft.getSize() == 2 * partitionSize);
+
+    auto bins = partitionSize + 1;
+
+    for(int partition = 0; partition < numPartitions; ++partition)
+    {
+        // zero padded to the transform size, so the products with the input are linear convolutions
+        std::copy(impulse + partition * partitionSize, impulse + (partition + 1) * partitionSize, buffer);
+        std::fill(buffer + partitionSize, buffer + 4 * partitionSize, 0.0f);
+        fft.performRealOnlyForwardTransform(buffer, true);
+
+        auto* re = real.data() + partition * bins;
+        auto* im = imag.data() + partition * bins;
+
+        for(int bin = 0; bin < bins; ++bin)
+        {
+            re[bin] = buffer[2 * bin];
+            im[bin] = buffer[2 * bin + 1];
+        }
+    }
+}
+
+void PartitionedConvolver::Scratch::prepare(int partitionSize)
+{
+    auto size = static_cast<size_t>(partitionSize);
+
+    fft = std::make_unique<juce::dsp::FFT>(juce::findHighestSetBit(static_cast<juce::uint32>(2 * partitionSize)));
+    sumReal.assign(size + 1, 0.0f);
+    sumImag.assign(size + 1, 0.0f);
+    transform.assign(4 * size, 0.0f);
+    faded.assign(size, 0.0f);
+}
+
+void PartitionedConvolver::prepare(int newPartitionSize, int newNumPartitions, int maxPushesAhead)
+{
+    jassert(juce::isPowerOfTwo(newPartitionSize));
+
+    partitionSize = newPartitionSize;
+    numPartitions = newNumPartitions;
+    numBins = partitionSize + 1;
+    fft = std::make_unique<juce::dsp::FFT>(juce::findHighestSetBit(static_cast<juce::uint32>(2 * partitionSize)));
+
+    numSlots = numPartitions + maxPushesAhead;
+
+    auto size = static_cast<size_t>(partitionSize);
+    delayLineReal.assign(static_cast<size_t>(numSlots) * (size + 1), 0.0f);
+    delayLineImag.assign(static_cast<size_t>(numSlots) * (size + 1), 0.0f);
+    transformBuffer.assign(4 * size, 0.0f);
+
+    reset();
+}
+
+void PartitionedConvolver::reset()
+{
+    std::fill(delayLineReal.begin(), delayLineReal.end(), 0.0f);
+    std::fill(delayLineImag.begin(), delayLineImag.end(), 0.0f);
+    delayLineIndex = 0;
+}
+
+int PartitionedConvolver::pushInput(const float* window)
+{
+    if(numPartitions == 0)
+        return 0;
+
+    auto* buffer = transformBuffer.data();
+
+    std::copy(window, window + 2 * partitionSize, buffer);
+    std::fill(buffer + 2 * partitionSize, buffer + 4 * partitionSize, 0.0f);
+    fft->performRealOnlyForwardTransform(buffer, true);
+
+    delayLineIndex = delayLineIndex == 0 ? numSlots - 1 : delayLineIndex - 1;
+    auto* re = delayLineReal.data() + delayLineIndex * numBins;
+    auto* im = delayLineImag.data() + delayLineIndex * numBins;
+
+    for(int bin = 0; bin < numBins; ++bin)
+    {
+        re[bin] = buffer[2 * bin];
+        im[bin] = buffer[2 * bin + 1];
+    }
+
+    return delayLineIndex;
+}
+
+void PartitionedConvolver::processPartition(int slot, float* result, const Kernel* kernel, const Kernel* previous, Fade fade,
+                                            Scratch& scratch) const
+{
+    if(numPartitions == 0)
+        return;
+
+    // the whole partition plays before the fade starts, only the old kernel is heard
+    if(! fade.isDone() && fade.start + static_cast<float>(partitionSize - 1) * fade.step <= 0.0f)
+        kernel = previous;
+
+    if(isUsable(kernel))
+        convolve(slot, *kernel, result, scratch);
+    else
+        std::fill(result, result + partitionSize, 0.0f);
+
+    if(fade.isDone() || kernel == previous)
+        return;
+
+    auto* faded = scratch.faded.data();
+
+    if(isUsable(previous))
+        convolve(slot, *previous, faded, scratch);
+    else
+        std::fill(faded, faded + partitionSize, 0.0f);
+
+    // both kernels are linear phase with the same delay, so a plain linear fade doesn't comb
+    for(int i = 0; i < partitionSize; ++i)
+    {
+        auto amount = juce::jlimit(0.0f, 1.0f, fade.start + static_cast<float>(i) * fade.step);
+        result[i] = faded[i] + amount * (result[i] - faded[i]);
+    }
+}
+
+void PartitionedConvolver::convolve(int slot, const Kernel& kernel, float* result, Scratch& scratch) const
+{
+    auto* sr = scratch.sumReal.data();
+    auto* si = scratch.sumImag.data();
+    std::fill(sr, sr + numBins, 0.0f);
+    std::fill(si, si + numBins, 0.0f);
+
+    // kernel partition k meets the input from k partitions before slot's
+    for(int partition = 0; partition < numPartitions; ++partition)
+    {
+        const auto* xr = delayLineReal.data() + slot * numBins;
+        const auto* xi = delayLineImag.data() + slot * numBins;
+        const auto* hr = kernel.real.data() + partition * numBins;
+        const auto* hi = kernel.imag.data() + partition * numBins;
+
+        for(int bin = 0; bin < numBins; ++bin)
+        {
+            sr[bin] += xr[bin] * hr[bin] - xi[bin] * hi[bin];
+            si[bin] += xr[bin] * hi[bin] + xi[bin] * hr[bin];
+        }
+
+        if(++slot == numSlots)
+            slot = 0;
+    }
+
+    auto* buffer = scratch.transform.data();
+
+    for(int bin = 0; bin < numBins; ++bin)
+    {
+        buffer[2 * bin] = sr[bin];
+        buffer[2 * bin + 1] = si[bin];
+    }
+
+    scratch.fft->performRealOnlyInverseTransform(buffer);
+
+    // the first half wrapped around, the second is the linear convolution
+    std::copy(buffer + partitionSize, buffer + 2 * partitionSize, result);
+}
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    PartitionedConvolver.h
+    Created: 19 Oct 2026 1:12:37am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <JuceHeader.h>
+
+// Uniformly partitioned overlap-save convolution of one channel with a stretch of a long FIR.  The
+// stretch is cut into partitions of partitionSize samples, each one transformed once when the kernel is
+// made.  Every partitionSize input samples the newest input partition is transformed into a frequency
+// domain delay line, multiplied with the kernel's partitions and summed, so one forward and one inverse
+// FFT of twice the partition size per partition covers the whole stretch.
+//
+// It doesn't buffer the input or the output, NonUniformConvolver does that for the several of these
+// it runs, with growing partition sizes, along one kernel.  Taking in a partition and working out its
+// output are separate calls, so the output can be worked out on another thread while newer partitions
+// come in.
+//
+// Works in float whatever the host precision, juce::dsp::FFT only does float.  The spectra are kept
+// as separate real and imaginary arrays so the multiply-adds vectorise.
+class PartitionedConvolver
+{
+public:
+    // A kernel in the form the convolver runs it, made off the audio thread by Kernel::set.
+    struct Kernel
+    {
+        // message thread
+        void allocate(int newPartitionSize, int newNumPartitions);
+
+        // Partitions and transforms the partitionSize * numPartitions samples from impulse.  fft has to be
+        // twice partitionSize, buffer 4 * partitionSize floats of scratch.
+        void set(const float* impulse, const juce::dsp::FFT& fft, float* buffer);
+
+        std::vector<float> real, imag;
+        int partitionSize {0};
+        int numPartitions {0};
+    };
+
+    // Where a crossfade from one kernel to another is at the first output sample of a partition, and
+    // how far it moves per sample.  Anything from 1 on is the new kernel alone.
+    struct Fade
+    {
+        bool isDone() const     { return start >= 1.0f; }
+
+        float start {1.0f};
+        float step {0.0f};
+    };
+
+    // What a call to processPartition works in.  Every thread that might be in one at the same time
+    // brings its own, FFT included.
+    struct Scratch
+    {
+        // message thread
+        void prepare(int partitionSize);
+
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::vector<float> sumReal, sumImag, transform, faded;
+    };
+
+    // Message thread.  Makes its own FFT, and has no kernel until one is passed to processPartition.
+    // maxPushesAhead is how many newer partitions can be pushed while a processPartition is still
+    // working on one.
+    void prepare(int newPartitionSize, int newNumPartitions, int maxPushesAhead);
+
+    int getPartitionSize() const    { return partitionSize; }
+    int getNumPartitions() const    { return numPartitions; }
+
+    // Doesn't allocate.
+    void reset();
+
+    // Audio thread, every partitionSize samples.  Transforms the newest input partition into the delay
+    // line, window holding it after the one before it, 2 * partitionSize samples, and returns the slot
+    // it went in for processPartition.
+    int pushInput(const float* window);
+
+    // Any thread.  Writes the partitionSize samples of output that go with the partition pushed to
+    // slot to result.  It only reads the delay line, so it can run alongside the next maxPushesAhead
+    // pushes.  A null kernel counts as silence, so a crossfade from one fades in.
+    void processPartition(int slot, float* result, const Kernel* kernel, const Kernel* previous, Fade fade,
+                          Scratch& scratch) const;
+
+private:
+    // the kernel's response to the delay line from slot back, partitionSize samples into result
+    void convolve(int slot, const Kernel& kernel, float* result, Scratch& scratch) const;
+
+    bool isUsable(const Kernel* kernel) const
+    {
+        return kernel != nullptr && kernel->partitionSize == partitionSize && kernel->numPartitions == numPartitions;
+    }
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    int partitionSize {0};
+    int numPartitions {0};
+    int numBins {0};
+
+    // The transformed input partitions, newest at delayLineIndex, then going back in time.  The
+    // spare slots, maxPushesAhead of them, keep a partition that's still being worked on from being
+    // written over.
+    std::vector<float> delayLineReal, delayLineImag;
+    int numSlots {0};
+    int delayLineIndex {0};
+
+    // pushInput's
+    std::vector<float> transformBuffer;
+};
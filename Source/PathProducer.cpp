@@ -26,8 +26,6 @@ PathProducer<BlockType>::~PathProducer()
 template<typename BlockType>
 void PathProducer<BlockType>::run()
 {
-    BlockType buffer;
-    
     previousTime = juce::Time::currentTimeMillis();
     
     while(!threadShouldExit())
@@ -44,11 +42,10 @@ void PathProducer<BlockType>::run()
         
         while(!threadShouldExit() && singleChannelSampleFifo->getNumCompleteBuffersAvailable() > 0)
         {
-            auto success = singleChannelSampleFifo->getAudioBuffer(buffer);
-            jassert(success);
-            juce::ignoreUnused(success);
+            auto* buffer = singleChannelSampleFifo->getNextAudioBuffer();
+            jassert(buffer != nullptr);
             
-            auto SCSFSize = buffer.getNumSamples();
+            auto SCSFSize = buffer->getNumSamples();
             jassert(SCSFSize <= BFGSize && BFGSize % SCSFSize == 0); //Spec requirement
             
             if(BFGSize > SCSFSize)
@@ -59,20 +56,23 @@ void PathProducer<BlockType>::run()
             }
             
             // copy SCSF into bufferForGenerator end.
-            bufferForGenerator.copyFrom(0, BFGSize - SCSFSize, buffer, 0, 0, SCSFSize);
+            bufferForGenerator.copyFrom(0, BFGSize - SCSFSize, *buffer, 0, 0, SCSFSize);
+            singleChannelSampleFifo->releaseAudioBuffer();
             
             fftDataGenerator.produceFFTDataForRendering(bufferForGenerator);
         }
         
         while(!threadShouldExit() && fftDataGenerator.getNumAvailableFFTDataBlocks() > 0)
         {
-            std::vector<float> fftData;
-            fftDataGenerator.getFFTData(fftData);
+            auto* fftData = fftDataGenerator.getNextFFTData();
+            jassert(fftData != nullptr);
             
             auto deltaT = juce::Time::currentTimeMillis() - previousTime;
             previousTime += deltaT;
             
-            updateRenderData(renderData, fftData, getNumBins(),  static_cast<float>(deltaT) * decayRateInDbPerSec.load() / 1000.f);
+            updateRenderData(renderData, *fftData, getNumBins(),  static_cast<float>(deltaT) * decayRateInDbPerSec.load() / 1000.f);
+            fftDataGenerator.releaseFFTData();
+            
             pathGenerator.generatePath(renderData, fftBounds, fftSize, getBinWidth(), negativeInfinity, maxDecibels);
         }
  
@@ -32,7 +32,7 @@ ParametricEQAudioProcessorEditor::ParametricEQAudioProcessorEditor (ParametricEQ
     
     nodeController.addNodeListener(&eqParamContainer);
  
-    setSize (1200, 800);
+    setSize (1500, 800);
     
 
     audioProcessor.addSampleRateListener(this);
@@ -113,11 +113,18 @@ void ParametricEQAudioProcessorEditor::timerCallback()
     
     if(outputFifo.getNumAvailableForReading() > 0)
     {
+        // an inter-sample over lasts a block, so the hold gets the loudest true peak since the last
+        // frame rather than only the newest block's.
+        Decibel<float> leftTruePeakDb {NEGATIVE_INFINITY}, rightTruePeakDb {NEGATIVE_INFINITY};
+        
         while(outputFifo.pull(values))
         {
-            // nothing
+            leftTruePeakDb = std::max(leftTruePeakDb, values.leftTruePeakDb);
+            rightTruePeakDb = std::max(rightTruePeakDb, values.rightTruePeakDb);
         }
         
+        values.leftTruePeakDb = leftTruePeakDb;
+        values.rightTruePeakDb = rightTruePeakDb;
         outputMeter.update(values);
     }
     
@@ -15,6 +15,7 @@
 #include "HighCutLowCutParameters.h"
 #include "TestFunctions.h"
 #include "GlobalParameters.h"
+#include "RealtimeAudit.h"
  
 #include <string>
 
@@ -72,7 +73,8 @@ bool ParametricEQAudioProcessor::isMidiEffect() const
 
 double ParametricEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // a pole on or outside the unit circle never rings out, the host still wants a number
+    return juce::jmin(tailLengthSeconds.load(), maxTailLengthSeconds);
 }
 
 int ParametricEQAudioProcessor::getNumPrograms()
@@ -104,25 +106,54 @@ void ParametricEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
+    numBusChannels = juce::jlimit(1, maxChannels, getTotalNumOutputChannels());
+    
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
+    spec.numChannels = static_cast<juce::uint32>(numBusChannels);
     spec.sampleRate = sampleRate;
     
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
-    // reuse spec
-    spec.numChannels = 2;
-    inputTrim.prepare(spec);
-    outputTrim.prepare(spec);
-    
-    
-    initializeFilters(leftChain, Channel::Left, sampleRate);
-    initializeFilters(rightChain, Channel::Right, sampleRate);
+    // the host picks the precision before calling prepareToPlay, but both are cheap to keep ready.
+    floatProcessing.prepare(spec);
+    doubleProcessing.prepare(spec);
+    
+    // both precisions use the same filter design, so either one's latency will do
+    oversamplingLatency[0] = 0;
+    for(int order = 1; order <= GlobalParameters::maxOversamplingOrder; ++order)
+        oversamplingLatency[static_cast<size_t>(order)] = juce::roundToInt(floatProcessing.getOversampler(order)->getLatencyInSamples());
+    
+    auto order = static_cast<int>(parameterTable.getOversampling());
+    oversamplingOrder = order;
+    auto processingSampleRate = sampleRate * (1 << order);
+    
+    // In linear phase it designs the kernels there and then, so the FIR path has them from the first
+    // sample.  Otherwise it holds nothing until phaseModeChanged switches it on.
+    auto linear = parameterTable.getPhaseMode() > 0.5f;
+    linearPhaseFilter.prepare(sampleRate, samplesPerBlock, numBusChannels, linear);
+    linearPhase = linear;
+    updateLatency();
+    
+    initializeFilters(leftChain, Channel::Left, processingSampleRate);
+    initializeFilters(rightChain, Channel::Right, processingSampleRate);
+    
+    // the chains start from each channel's own parameters, the first block sorts out stereo.
+    changedBands.markAll();
+    automationRamps.prepare(sampleRate, rampTime);
+    
+    // start from the initial coefficients instead of ramping in from the previous settings.
+    loadFilterEngine(floatProcessing.filterEngine);
+    loadFilterEngine(doubleProcessing.filterEngine);
+    floatProcessing.filterEngine.reset();
+    doubleProcessing.filterEngine.reset();
  
     leftSCSFifo.prepare(SCSF_SIZE);
     rightSCSFifo.prepare(SCSF_SIZE);
     
+    // a second of silence also gives the meters and the analyzer time to show it before they stop getting updates.
+    silenceDetector.prepare(static_cast<int>(sampleRate));
+    tailLengthSeconds = linear ? linearPhaseFilter.getTailLengthSamples() / sampleRate
+                               : floatProcessing.filterEngine.getTailLengthSamples() / processingSampleRate;
+    
     sampleRateListeners.call([sampleRate](SampleRateListener& srl){srl.sampleRateChanged(sampleRate);});
  
     
@@ -148,8 +179,8 @@ bool ParametricEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     return true;
   #else
     
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    auto outputs = layouts.getMainOutputChannelSet();
+    if (outputs.isDisabled() || outputs.size() > maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -163,35 +194,27 @@ bool ParametricEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 }
 #endif
 
-void ParametricEQAudioProcessor::performMidSideTransform(juce::AudioBuffer<float>& buffer)
+bool ParametricEQAudioProcessor::supportsDoublePrecisionProcessing() const
 {
-    // AKA Hadamard transformation
-    // Anew = (A+B)/sqrt(2), Bnew = (A-B)/sqrt(2)
-    // note that this is involutory , i.e. a second call will undo the transformation
-    
-    static const float minus3db = 1.0f/juce::MathConstants<float>::sqrt2;
-
-    auto leftReadPtr = buffer.getReadPointer(0);
-    auto rightReadPtr = buffer.getReadPointer(1);
-
-    auto leftWritePtr = buffer.getWritePointer(0);
-    auto rightWritePtr = buffer.getWritePointer(1);
-    
-    int numSamples = buffer.getNumSamples();
+    return true;
+}
 
-    for( int i=0; i < numSamples; i++ )
-    {
-         auto M = (leftReadPtr[i] + rightReadPtr[i]) * minus3db;
-         auto S = (leftReadPtr[i] - rightReadPtr[i]) * minus3db;
+void ParametricEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    processBlockInternal(buffer, floatProcessing);
+}
 
-         leftWritePtr[i] = M;
-         rightWritePtr[i] = S;
-    }
+void ParametricEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    processBlockInternal(buffer, doubleProcessing);
 }
 
-void ParametricEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+template <typename SampleType>
+void ParametricEQAudioProcessor::processBlockInternal (juce::AudioBuffer<SampleType>& buffer, ProcessingState<SampleType>& state)
 {
     juce::ScopedNoDenormals noDenormals;
+    RealtimeAudit::ScopedRealtimeThread realtimeThread;
+    auto& filterEngine = state.filterEngine;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     
@@ -204,19 +227,61 @@ void ParametricEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
          buffer.clear (i, 0, buffer.getNumSamples());
     
-    updateTrims();
+    auto numChannels = juce::jmin(totalNumOutputChannels, numBusChannels);
+    
+    // Dual mono and mid/side only mean something for a pair, wider buses are always linked.  Mono runs
+    // the left channel's parameters alone.
+    auto mono = numChannels == 1;
+    ChannelMode mode = numChannels != 2 ? ChannelMode::Stereo : static_cast<ChannelMode>(parameterTable.getProcessingMode());
+    
+    auto newOversamplingOrder = static_cast<int>(parameterTable.getOversampling());
+    if(newOversamplingOrder != oversamplingOrder)
+        changeOversamplingOrder(newOversamplingOrder, state);
     
-    ChannelMode mode = static_cast<ChannelMode>(apvts.getRawParameterValue(GlobalParameters::processingModeName)->load());
+    // The FIR path only takes over once it has kernels for the parameters as they are.  Offline that's
+    // straight away, otherwise the IIR path plays on while phaseModeChanged sets the filter up and the
+    // worker designs them.
+    linearPhaseFilter.setNonRealtime(isNonRealtime());
+    bool wantsLinearPhase = parameterTable.getPhaseMode() > 0.5f;
     
-    performPreLoopUpdate(mode, getSampleRate());
+    if(wantsLinearPhase == linearPhase)
+        linearPhaseFilter.cancelStart();
+    else if(! wantsLinearPhase || linearPhaseFilter.readyToStart())
+        changePhaseMode(wantsLinearPhase, state);
     
-    juce::dsp::AudioBlock<float> block(buffer);
+    // only this thread changes them, so one read of each holds for the whole block
+    auto order = oversamplingOrder.load();
+    auto linear = linearPhase.load();
+    auto processingSampleRate = getSampleRate() * (1 << order);
+    
+    // The kernels are made from the parameters themselves, the job picks up any change along the way.
+    // A switch to linear phase that's waiting for its kernels wants the change too.
+    if(performPreLoopUpdate(mode, processingSampleRate, buffer.getNumSamples()) && (linear || wantsLinearPhase))
+        linearPhaseFilter.requestDesign();
     
     int numSamples = buffer.getNumSamples();
-    int offset = 0;
     
-    juce::dsp::ProcessContextReplacing<float> stereoContext(block);
-    inputTrim.process(stereoContext);
+    bool inputIsSilent = silenceDetector.update(buffer);
+    
+#if USE_TEST_OSC || USE_WHITE_NOISE
+    inputIsSilent = false;
+#endif
+    
+    if(inputIsSilent && silenceDetector.hasBeenSilentLongEnough() && filterEngine.getStateMagnitude() < SilenceDetector::threshold)
+    {
+        // Nothing coming in and nothing left ringing in the filters, so skip the filters, trims, meters and analyzer.
+        // The parameters still move so the filters are up to date when the input comes back.
+        performInnerLoopUpdate(numSamples << order);
+        filterEngine.reset();
+        
+        if(! linear)
+            tailLengthSeconds = filterEngine.getTailLengthSamples() / processingSampleRate;
+        
+        for (auto i = 0; i < totalNumOutputChannels; ++i)
+            buffer.clear (i, 0, numSamples);
+        
+        return;
+    }
     
 #if USE_TEST_OSC
     using namespace AnalyzerProperties;
@@ -258,64 +323,120 @@ void ParametricEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     }
 
 #endif
+    
+    // the trims are steady across a block, so they fold into whatever else touches every sample.
+    auto inputGain = static_cast<SampleType>(FastMath::decibelsToGain(parameterTable.getInTrim()));
+    auto outputGain = static_cast<SampleType>(FastMath::decibelsToGain(parameterTable.getOutTrim()));
+    
+    auto* left = buffer.getWritePointer(0);
+    auto* right = mono ? nullptr : buffer.getWritePointer(1);
+    
     using namespace AnalyzerProperties;
     
-    auto analyzerEnabled = apvts.getRawParameterValue(getAnalyzerParamName(ParamNames::EnableAnalyzer))->load() > 0.;
+    auto analyzerEnabled = parameterTable.getAnalyzerEnabled() > 0.;
     
-    auto analyzerMode = static_cast<ProcessingModes> (apvts.getRawParameterValue(getAnalyzerParamName(ParamNames::AnalyzerProcessingMode))->load()) ;
+    auto analyzerMode = static_cast<ProcessingModes> (parameterTable.getAnalyzerMode()) ;
+    
+    auto feedPreAnalyzer = editorActive && analyzerEnabled && analyzerMode == ProcessingModes::Pre;
+    auto feedPostAnalyzer = editorActive && analyzerEnabled && analyzerMode == ProcessingModes::Post;
+    
+    // trim, input meters and mid/side encode share one pass, unless the analyzer has to see
+    // the trimmed left and right before the encode.
+    auto encodeWithTrim = mode == ChannelMode::MidSide && ! feedPreAnalyzer;
+    StereoKernels::Levels<SampleType> levels;
+    
+    if(mono)
+        StereoKernels::processStage(left, numSamples, inputGain, editorActive ? &levels : nullptr);
+    else
+        StereoKernels::processStage(left, right, numSamples, inputGain,
+                                    encodeWithTrim ? StereoKernels::MidSide::Encode : StereoKernels::MidSide::None,
+                                    editorActive ? &levels : nullptr);
     
     if(editorActive)
+        inMeterValuesFifo.push(makeMeterValues(levels, numSamples));
+    
+    if(feedPreAnalyzer)
     {
-        if(analyzerEnabled && analyzerMode == ProcessingModes::Pre)
-        {
-            leftSCSFifo.update(buffer);
-            rightSCSFifo.update(buffer);
-        }
+        leftSCSFifo.update(buffer);
         
-        updateMeterFifos(inMeterValuesFifo, buffer);
-    }
- 
-    if(mode == ChannelMode::MidSide)
-    {
-        performMidSideTransform(buffer);
+        if(! mono)
+            rightSCSFifo.update(buffer);
     }
     
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    if(mode == ChannelMode::MidSide && ! encodeWithTrim)
+        StereoKernels::processStage(left, right, numSamples, static_cast<SampleType>(1), StereoKernels::MidSide::Encode);
+    
+    // the rest of a surround or ambisonic bus just needs the trim
+    for(int channel = 2; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel), inputGain, numSamples);
     
-    while(offset < numSamples)
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    
+    if(linear)
     {
-        int blockSize = std::min(numSamples - offset, innerLoopSize);
-        auto leftSubBlock =  leftBlock.getSubBlock(offset, blockSize);
-        auto rightSubBlock = rightBlock.getSubBlock(offset, blockSize);
- 
-        performInnerLoopUpdate(blockSize);
+        // The FIR runs at the host rate whatever the oversampling, the kernel already has the response
+        // of the chains at the oversampled rate.  The chains keep smoothing so a switch back is seamless.
+        performInnerLoopUpdate(numSamples << order);
+        linearPhaseFilter.process(channels, numChannels, numSamples);
+        tailLengthSeconds = linearPhaseFilter.getTailLengthSamples() / getSampleRate();
+    }
+    // coefficients are ramped per sample inside the engine, so a settled block goes in one go.
+    else if(auto* oversampler = state.getOversampler(order))
+    {
+        // up where the bilinear transform's cramping is well above the audio band, and back
+        juce::dsp::AudioBlock<SampleType> block(channels, static_cast<size_t>(numChannels), static_cast<size_t>(numSamples));
+        auto upsampled = oversampler->processSamplesUp(block);
+        
+        std::array<SampleType*, maxChannels> upsampledChannels {};
+        for(int channel = 0; channel < numChannels; ++channel)
+            upsampledChannels[static_cast<size_t>(channel)] = upsampled.getChannelPointer(static_cast<size_t>(channel));
+        
+        auto numUpsampled = static_cast<int>(upsampled.getNumSamples());
         
-        juce::dsp::ProcessContextReplacing<float> leftContext(leftSubBlock);
-        juce::dsp::ProcessContextReplacing<float> rightContext(rightSubBlock);
-        leftChain.process(leftContext);
-        rightChain.process(rightContext);
-                
-        offset += innerLoopSize;
+        processFilters(filterEngine, upsampledChannels.data(), numChannels, numUpsampled);
+        
+        oversampler->processSamplesDown(block);
     }
-    
-    if(mode == ChannelMode::MidSide)
+    else
     {
-        performMidSideTransform(buffer);
+        processFilters(filterEngine, channels, numChannels, numSamples);
     }
     
-
+    if(! linear)
+        tailLengthSeconds = filterEngine.getTailLengthSamples() / processingSampleRate;
+    
+    // decode, output trim and output meters in one pass
+    if(mono)
+        StereoKernels::processStage(left, numSamples, outputGain, editorActive ? &levels : nullptr);
+    else
+        StereoKernels::processStage(left, right, numSamples, outputGain,
+                                    mode == ChannelMode::MidSide ? StereoKernels::MidSide::Decode : StereoKernels::MidSide::None,
+                                    editorActive ? &levels : nullptr);
     
-    outputTrim.process(stereoContext);
+    for(int channel = 2; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel), outputGain, numSamples);
     
     if(editorActive)
     {
-        if(analyzerEnabled && analyzerMode == ProcessingModes::Post)
-        {
-            leftSCSFifo.update(buffer);
+        // the detectors only run while someone is looking, so the first block after the
+        // editor opens interpolates against old history.  One block of one meter reading.
+        auto values = makeMeterValues(levels, numSamples);
+        values.leftTruePeakDb.setGain(static_cast<float>(state.truePeakDetectors[0].process(left, numSamples)));
+        
+        if(mono)
+            values.rightTruePeakDb = values.leftTruePeakDb;
+        else
+            values.rightTruePeakDb.setGain(static_cast<float>(state.truePeakDetectors[1].process(right, numSamples)));
+        
+        outMeterValuesFifo.push(values);
+    }
+    
+    if(feedPostAnalyzer)
+    {
+        leftSCSFifo.update(buffer);
+        
+        if(! mono)
             rightSCSFifo.update(buffer);
-        }
-        updateMeterFifos(outMeterValuesFifo, buffer);
     }
     
 #if USE_TEST_OSC || USE_WHITE_NOISE
@@ -325,6 +446,56 @@ void ParametricEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 #endif
 }
 
+// Everything prepareToPlay does for the filters, at the new rate.  The oversamplers and the engine
+// were sized for the largest factor there, so none of this allocates.
+template <typename SampleType>
+void ParametricEQAudioProcessor::changeOversamplingOrder(int newOrder, ProcessingState<SampleType>& state)
+{
+    oversamplingOrder = newOrder;
+    
+    auto processingSampleRate = getSampleRate() * (1 << newOrder);
+    initializeFilters(leftChain, Channel::Left, processingSampleRate);
+    initializeFilters(rightChain, Channel::Right, processingSampleRate);
+    changedBands.markAll();
+    
+    loadFilterEngine(state.filterEngine);
+    state.filterEngine.reset();
+    
+    if(auto* oversampler = state.getOversampler(newOrder))
+        oversampler->reset();
+}
+
+// The two paths have different latencies, so neither one's state means anything to the other.
+// Both start clean, the FIR one with kernels already made for the parameters as they are.
+template <typename SampleType>
+void ParametricEQAudioProcessor::changePhaseMode(bool linear, ProcessingState<SampleType>& state)
+{
+    linearPhase = linear;
+    
+    loadFilterEngine(state.filterEngine);
+    state.filterEngine.reset();
+    
+    if(auto* oversampler = state.getOversampler(oversamplingOrder.load()))
+        oversampler->reset();
+}
+
+void ParametricEQAudioProcessor::phaseModeChanged()
+{
+    // the audio thread only switches once the filter has its convolvers and kernels
+    if(parameterTable.getPhaseMode() > 0.5f)
+        linearPhaseFilter.activate();
+
+    updateLatency();
+}
+
+void ParametricEQAudioProcessor::updateLatency()
+{
+    if(parameterTable.getPhaseMode() > 0.5f)
+        setLatencySamples(linearPhaseFilter.getLatencySamples());
+    else
+        setLatencySamples(oversamplingLatency[static_cast<size_t>(parameterTable.getOversampling())]);
+}
+
 //==============================================================================
 bool ParametricEQAudioProcessor::hasEditor() const
 {
@@ -352,8 +523,9 @@ void ParametricEQAudioProcessor::setStateInformation (const void* data, int size
      if (xmlState.get() != nullptr)
                 if (xmlState->hasTagName (apvts.state.getType()))
                     apvts.replaceState (juce::ValueTree::fromXml (*xmlState));
-    initializeFilters(leftChain, Channel::Left, getSampleRate());
-    initializeFilters(rightChain, Channel::Right, getSampleRate());
+    
+    // the chains belong to the audio thread, its next block sets every band up from the new state
+    changedBands.markAll();
 }
 
 //==============================================================================
@@ -435,6 +607,12 @@ ParamLayout ParametricEQAudioProcessor::createParameterLayout()
                                                            juce::NormalisableRange<float>(-18.f, 18.f, 0.25f, 1.0f), 0.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>(GlobalParameters::outTrimName, GlobalParameters::outTrimName,
                                                            juce::NormalisableRange<float>(-18.f, 18.f, 0.25f, 1.0f), 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(GlobalParameters::oversamplingName, GlobalParameters::oversamplingName,
+                                                            GlobalParameters::oversamplingChoices, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(GlobalParameters::filterDesignName, GlobalParameters::filterDesignName,
+                                                            GlobalParameters::filterDesignChoices, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(GlobalParameters::phaseModeName, GlobalParameters::phaseModeName,
+                                                            GlobalParameters::phaseModeChoices, 0));
     createFilterLayouts(layout, Channel::Left);
     createFilterLayouts(layout, Channel::Right);
     
@@ -450,24 +628,55 @@ void ParametricEQAudioProcessor::initializeFilters(ChainHelpers::MonoFilterChain
     auto messMan = juce::MessageManager::getInstanceWithoutCreating();
     bool onRealTimeThread=  ! ((messMan != nullptr) && messMan->isThisTheMessageThread());
      
-    ChainHelpers::initializeFilters(chain, channel, apvts, rampTime, onRealTimeThread, sampleRate);
+    ChainHelpers::initializeFilters(chain, channel, parameterTable, rampTime, onRealTimeThread, sampleRate);
 }
 
 
-void ParametricEQAudioProcessor::performPreLoopUpdate(ChannelMode mode, double sampleRate)
+// returns whether any band needed updating
+bool ParametricEQAudioProcessor::performPreLoopUpdate(ChannelMode mode, double sampleRate, int numSamples)
 {
-    preUpdateCutFilter<ChainPosition::LowCut>(mode, sampleRate);
-    preUpdateParametricFilter<ChainPosition::LowShelf>(mode, sampleRate);
-    preUpdateParametricFilter<ChainPosition::PeakFilter1>(mode, sampleRate);
-    preUpdateParametricFilter<ChainPosition::PeakFilter2>(mode, sampleRate);
-    preUpdateParametricFilter<ChainPosition::PeakFilter3>(mode, sampleRate);
-    preUpdateParametricFilter<ChainPosition::PeakFilter4>(mode, sampleRate);
-    preUpdateParametricFilter<ChainPosition::HighShelf>(mode, sampleRate);
-    preUpdateCutFilter<ChainPosition::HighCut>(mode, sampleRate);
+    auto changed = changedBands.take();
+    
+    // switching in or out of stereo changes where the right channel's parameters come from
+    if(mode != lastMode)
+    {
+        changed = BandChangeMask::allBands;
+        lastMode = mode;
+    }
+    
+    // so does the filter design, for the shelves and peaks of both channels
+    bool matchedDesign = parameterTable.getFilterDesign() > 0.5f;
+    if(matchedDesign != lastMatchedDesign)
+    {
+        changed = BandChangeMask::allBands;
+        lastMatchedDesign = matchedDesign;
+    }
+    
+    // every block, so the time between a band's changes counts the blocks it didn't change in
+    automationRamps.update(changed, numSamples);
+    
+    if(changed == 0)
+        return false;
+    
+    activeBands |= changed;
+    
+    preUpdateCutFilter<ChainPosition::LowCut>(mode, sampleRate, changed);
+    preUpdateParametricFilter<ChainPosition::LowShelf>(mode, sampleRate, changed);
+    preUpdateParametricFilter<ChainPosition::PeakFilter1>(mode, sampleRate, changed);
+    preUpdateParametricFilter<ChainPosition::PeakFilter2>(mode, sampleRate, changed);
+    preUpdateParametricFilter<ChainPosition::PeakFilter3>(mode, sampleRate, changed);
+    preUpdateParametricFilter<ChainPosition::PeakFilter4>(mode, sampleRate, changed);
+    preUpdateParametricFilter<ChainPosition::HighShelf>(mode, sampleRate, changed);
+    preUpdateCutFilter<ChainPosition::HighCut>(mode, sampleRate, changed);
+    
+    return true;
 }
 
 void ParametricEQAudioProcessor::performInnerLoopUpdate(int numSamplesToSkip)
 {
+    if(activeBands == 0)
+        return;
+    
     loopUpdateCutFilter<ChainPosition::LowCut>(numSamplesToSkip);
     loopUpdateParametricFilter<ChainPosition::LowShelf>(numSamplesToSkip);
     loopUpdateParametricFilter<ChainPosition::PeakFilter1>(numSamplesToSkip);
@@ -478,31 +687,49 @@ void ParametricEQAudioProcessor::performInnerLoopUpdate(int numSamplesToSkip)
     loopUpdateCutFilter<ChainPosition::HighCut>(numSamplesToSkip);
 }
 
-void ParametricEQAudioProcessor::updateTrims()
+template <typename EngineType, typename SampleType>
+void ParametricEQAudioProcessor::processFilters(EngineType& engine, SampleType* const* channels, int numChannels, int numSamples)
 {
+    // A matched design costs nearly twice a bilinear one, so with them the segments are twice as long
+    // and a smoothing band costs no more design time per sample than it does with bilinear designs.
+    auto segment = lastMatchedDesign ? 2 * maxSmoothingSegment : maxSmoothingSegment;
     
-    float inputGain= apvts.getRawParameterValue(GlobalParameters::inTrimName)->load();
-    float outputGain = apvts.getRawParameterValue(GlobalParameters::outTrimName)->load();
-    inputTrim.setGainDecibels(inputGain);
-    outputTrim.setGainDecibels(outputGain);
- 
+    for(int start = 0; start < numSamples;)
+    {
+        auto count = activeBands == 0 ? numSamples - start : juce::jmin(numSamples - start, segment);
+        
+        performInnerLoopUpdate(count);
+        engine.process(channels, static_cast<size_t>(numChannels), start, count);
+        start += count;
+    }
 }
 
-
+template <typename EngineType>
+void ParametricEQAudioProcessor::loadFilterEngine(EngineType& engine)
+{
+    copyFilterToEngine<ChainPosition::LowCut>(engine);
+    copyFilterToEngine<ChainPosition::LowShelf>(engine);
+    copyFilterToEngine<ChainPosition::PeakFilter1>(engine);
+    copyFilterToEngine<ChainPosition::PeakFilter2>(engine);
+    copyFilterToEngine<ChainPosition::PeakFilter3>(engine);
+    copyFilterToEngine<ChainPosition::PeakFilter4>(engine);
+    copyFilterToEngine<ChainPosition::HighShelf>(engine);
+    copyFilterToEngine<ChainPosition::HighCut>(engine);
+}
 
 bool ParametricEQAudioProcessor::isAnyActiveOn()
 {
-    ChannelMode mode = static_cast<ChannelMode>(apvts.getRawParameterValue(GlobalParameters::processingModeName)->load());
+    ChannelMode mode = static_cast<ChannelMode>(parameterTable.getProcessingMode());
     
     bool isAnyOn = false;
     
     for(int filterNum = 0; filterNum < 8; ++filterNum)
     {
-        bool isOn = apvts.getRawParameterValue(createBypassParamString(Channel::Left, static_cast<ChainPosition>(filterNum)))->load() < 0.5f;
+        bool isOn = parameterTable.get(Channel::Left, static_cast<ChainPosition>(filterNum), ParameterTable::Field::Bypass) < 0.5f;
         isAnyOn |= isOn;
         if(mode != ChannelMode::Stereo)
         {
-            isOn = apvts.getRawParameterValue(createBypassParamString(Channel::Right, static_cast<ChainPosition>(filterNum)))->load() < 0.5f;
+            isOn = parameterTable.get(Channel::Right, static_cast<ChainPosition>(filterNum), ParameterTable::Field::Bypass) < 0.5f;
             isAnyOn |= isOn;
         }
     }
@@ -15,27 +15,33 @@
 #include <JuceHeader.h>
 #include "HighCutLowCutParameters.h"
 #include "FilterParameters.h"
-#include "Fifo.h"
+#include "SpscRing.h"
 #include "CoefficientsMaker.h"
 #include "ParameterHelpers.h"
 #include "FilterCoefficientGenerator.h"
-#include "ReleasePool.h"
 #include "FilterLink.h"
 #include "MeterValues.h"
 #include "SingleChannelSampleFifo.h"
 #include "FFTDataGenerator.h"
 #include "AnalyzerProperties.h"
 #include "ChainHelpers.h"
+#include "ParameterTable.h"
+#include "AutomationRamps.h"
+#include "BandChangeMask.h"
+#include "BiquadEngine.h"
+#include "SilenceDetector.h"
+#include "StereoKernels.h"
+#include "TruePeakDetector.h"
+#include "LinearPhaseFilter.h"
+#include "GlobalParameters.h"
+#include "ParamListener.h"
 
 #define SCSF_SIZE 2048
 
  
-using Trim = juce::dsp::Gain<float>;
- 
 using ParamLayout = juce::AudioProcessorValueTreeState::ParameterLayout;
 
-const float rampTime = 0.05f;  //50 mseconds
-const int innerLoopSize = 32;
+const float rampTime = 0.05f;  //50 mseconds, the longest a band takes to reach a new value, see AutomationRamps
  
 
 
@@ -57,7 +63,9 @@ public:
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
    #endif
 
+    bool supportsDoublePrecisionProcessing() const override;
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -98,6 +106,9 @@ public:
     void addSampleRateListener (SampleRateListener*);
     void removeSampleRateListener (SampleRateListener*);
     
+    // for the benchmark to see how the convolution workers kept up
+    const LinearPhaseFilter& getLinearPhaseFilter() const { return linearPhaseFilter; }
+    
   
      
     juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Params", createParameterLayout() };
@@ -105,7 +116,7 @@ public:
     // Buffers for meters and fft. 30 should be plenty, timer goes at 60 times a second,
     // which is a duration of about 768 samples as 48k, which should only be few blocks.  
     //Fifo<juce::AudioBuffer<float>, 30> inputBuffers;
-    Fifo<MeterValues, 30> inMeterValuesFifo, outMeterValuesFifo;
+    SpscRing<MeterValues, 30> inMeterValuesFifo, outMeterValuesFifo;
     
     SingleChannelSampleFifo<juce::AudioBuffer<float>>  leftSCSFifo{Channel::Left}, rightSCSFifo{Channel::Right};
     
@@ -123,88 +134,255 @@ private:
     
     void setBoolParamState(bool state, juce::AudioParameterBool* param);
     
-    template<typename T, typename U>
-    void updateMeterFifos(T& fifo, U& buffer)
+    // the true peak is left at the sample peak, for stages that don't measure it
+    template<typename SampleType>
+    static MeterValues makeMeterValues(const StereoKernels::Levels<SampleType>& levels, int numSamples)
     {
+        using Levels = StereoKernels::Levels<SampleType>;
         MeterValues values;
         
-        values.leftPeakDb.setGain(buffer.getMagnitude(0, 0, buffer.getNumSamples()));
-        values.rightPeakDb.setGain(buffer.getMagnitude(1, 0, buffer.getNumSamples()));
-        values.leftRmsDb.setGain(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
-        values.rightRmsDb.setGain(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
+        values.leftPeakDb.setGain(static_cast<float>(levels.leftPeak));
+        values.rightPeakDb.setGain(static_cast<float>(levels.rightPeak));
+        values.leftRmsDb.setGain(static_cast<float>(Levels::getRms(levels.leftSumOfSquares, numSamples)));
+        values.rightRmsDb.setGain(static_cast<float>(Levels::getRms(levels.rightSumOfSquares, numSamples)));
+        values.leftTruePeakDb = values.leftPeakDb;
+        values.rightTruePeakDb = values.rightPeakDb;
         
-        fifo.push(values);
+        return values;
     }
     
     
+    // in stereo the right channel follows the left channel's parameters, so only the left bit counts.
     template <const ChainPosition chainPos>
-    void preUpdateParametricFilter(ChannelMode mode, double sampleRate)
+    void preUpdateParametricFilter(ChannelMode mode, double sampleRate, BandChangeMask::Mask changedBands)
     {
         using namespace ChainHelpers;
-        FilterParameters parametricParamsLeft = getParametericFilterParams(chainPos, Channel::Left, sampleRate, apvts);
-        FilterParameters parametricParamsRight;
-        
-        if(mode == ChannelMode::Stereo)
-            parametricParamsRight = parametricParamsLeft;
-        else
-            parametricParamsRight = getParametericFilterParams(chainPos, Channel::Right, sampleRate, apvts);
+        bool leftChanged = (changedBands & BandChangeMask::getBit(Channel::Left, chainPos)) != 0;
+        bool rightChanged = mode == ChannelMode::Stereo ? leftChanged
+                                                        : (changedBands & BandChangeMask::getBit(Channel::Right, chainPos)) != 0;
         
         constexpr int filterNum = static_cast<int>(chainPos);
-        leftChain.get<filterNum>().performPreloopUpdate(parametricParamsLeft);
-        rightChain.get<filterNum>().performPreloopUpdate(parametricParamsRight);
+        
+        if(leftChanged)
+            leftChain.get<filterNum>().performPreloopUpdate(getParametericFilterParams(chainPos, Channel::Left, sampleRate, parameterTable),
+                                                            automationRamps.getRampSeconds(Channel::Left, chainPos));
+        
+        if(rightChanged && numBusChannels > 1)
+        {
+            auto channel = mode == ChannelMode::Stereo ? Channel::Left : Channel::Right;
+            rightChain.get<filterNum>().performPreloopUpdate(getParametericFilterParams(chainPos, channel, sampleRate, parameterTable),
+                                                             automationRamps.getRampSeconds(channel, chainPos));
+        }
     }
     
     
     template <const ChainPosition chainPos>
     void loopUpdateParametricFilter(int samplesToSkip)
     {
+        constexpr auto bits = BandChangeMask::getBit(Channel::Left, chainPos) | BandChangeMask::getBit(Channel::Right, chainPos);
+        if((activeBands & bits) == 0)
+            return;
+        
         constexpr int filterNum = static_cast<int>(chainPos);
-        leftChain.get<filterNum>().performInnerLoopFilterUpdate(true, samplesToSkip);
-        rightChain.get<filterNum>().performInnerLoopFilterUpdate(true, samplesToSkip);
+        auto& left = leftChain.get<filterNum>();
+        auto& right = rightChain.get<filterNum>();
+        left.performInnerLoopFilterUpdate(true, samplesToSkip);
+        
+        // a mono bus never runs the right chain
+        auto mono = numBusChannels == 1;
+        if(! mono)
+            right.performInnerLoopFilterUpdate(true, samplesToSkip);
+        
+        copyFilterToEngine<chainPos>();
+        
+        if(left.isSettled() && (mono || right.isSettled()))
+            activeBands &= ~bits;
     }
     
     template <const ChainPosition chainPos>
-    void preUpdateCutFilter(ChannelMode mode, double sampleRate)
+    void preUpdateCutFilter(ChannelMode mode, double sampleRate, BandChangeMask::Mask changedBands)
     {
         using namespace ChainHelpers;
-        HighCutLowCutParameters cutParamsLeft = getCutFilterParams(chainPos, Channel::Left, sampleRate, apvts);
-        HighCutLowCutParameters cutParamsRight;
-        
-        if(mode == ChannelMode::Stereo)
-            cutParamsRight = cutParamsLeft;
-        else
-            cutParamsRight = getCutFilterParams(chainPos, Channel::Right, sampleRate, apvts);
+        bool leftChanged = (changedBands & BandChangeMask::getBit(Channel::Left, chainPos)) != 0;
+        bool rightChanged = mode == ChannelMode::Stereo ? leftChanged
+                                                        : (changedBands & BandChangeMask::getBit(Channel::Right, chainPos)) != 0;
         
         constexpr int filterNum = static_cast<int>(chainPos);
-        leftChain.get<filterNum>().performPreloopUpdate(cutParamsLeft);
-        rightChain.get<filterNum>().performPreloopUpdate(cutParamsRight);
+        
+        if(leftChanged)
+            leftChain.get<filterNum>().performPreloopUpdate(getCutFilterParams(chainPos, Channel::Left, sampleRate, parameterTable),
+                                                            automationRamps.getRampSeconds(Channel::Left, chainPos));
+        
+        if(rightChanged && numBusChannels > 1)
+        {
+            auto channel = mode == ChannelMode::Stereo ? Channel::Left : Channel::Right;
+            rightChain.get<filterNum>().performPreloopUpdate(getCutFilterParams(chainPos, channel, sampleRate, parameterTable),
+                                                             automationRamps.getRampSeconds(channel, chainPos));
+        }
     }
     
     template <const ChainPosition chainPos>
     void loopUpdateCutFilter(int samplesToSkip)
     {
+        constexpr auto bits = BandChangeMask::getBit(Channel::Left, chainPos) | BandChangeMask::getBit(Channel::Right, chainPos);
+        if((activeBands & bits) == 0)
+            return;
+        
         constexpr int filterNum = static_cast<int>(chainPos);
-        leftChain.get<filterNum>().performInnerLoopFilterUpdate(true, samplesToSkip);
-        rightChain.get<filterNum>().performInnerLoopFilterUpdate(true, samplesToSkip);
+        auto& left = leftChain.get<filterNum>();
+        auto& right = rightChain.get<filterNum>();
+        left.performInnerLoopFilterUpdate(true, samplesToSkip);
+        
+        // a mono bus never runs the right chain
+        auto mono = numBusChannels == 1;
+        if(! mono)
+            right.performInnerLoopFilterUpdate(true, samplesToSkip);
+        
+        copyFilterToEngine<chainPos>();
+        
+        if(left.isSettled() && (mono || right.isSettled()))
+            activeBands &= ~bits;
     }
     
     
    
     
+    template <const ChainPosition chainPos, typename EngineType>
+    void copyFilterToEngine(EngineType& engine)
+    {
+        constexpr int filterNum = static_cast<int>(chainPos);
+        constexpr size_t firstSection = ChainHelpers::getFirstSection(chainPos);
+        leftChain.get<filterNum>().copyCoefficientsToEngine(engine, firstSection, 0);
+        
+        // every channel past the left follows the right chain, which follows the left when linked
+        for(size_t channel = 1; channel < static_cast<size_t>(numBusChannels); ++channel)
+            rightChain.get<filterNum>().copyCoefficientsToEngine(engine, firstSection, channel);
+    }
+    
+    // into whichever engine the host is running
+    template <const ChainPosition chainPos>
+    void copyFilterToEngine()
+    {
+        if(isUsingDoublePrecision())
+            copyFilterToEngine<chainPos>(doubleProcessing.filterEngine);
+        else
+            copyFilterToEngine<chainPos>(floatProcessing.filterEngine);
+    }
+    
+    // everything that runs at the host's precision
+    template <typename SampleType>
+    struct ProcessingState
+    {
+        void prepare(const juce::dsp::ProcessSpec& spec)
+        {
+            using Oversampling = juce::dsp::Oversampling<SampleType>;
+            
+            // room for the largest factor, so switching never reallocates on the audio thread
+            filterEngine.prepare(static_cast<int>(spec.maximumBlockSize) << GlobalParameters::maxOversamplingOrder,
+                                 static_cast<int>(spec.numChannels));
+            
+            for(size_t order = 1; order <= static_cast<size_t>(GlobalParameters::maxOversamplingOrder); ++order)
+            {
+                // polyphase half band IIRs, much cheaper than the FIRs for the same rejection,
+                // with the latency rounded to whole samples so the host can compensate it exactly.
+                auto& oversampler = oversamplers[order - 1];
+                oversampler = std::make_unique<Oversampling>(spec.numChannels, order, Oversampling::filterHalfBandPolyphaseIIR, true, true);
+                oversampler->initProcessing(spec.maximumBlockSize);
+            }
+            
+            for(auto& detector : truePeakDetectors)
+                detector.reset();
+        }
+        
+        juce::dsp::Oversampling<SampleType>* getOversampler(int order)
+        {
+            return order > 0 ? oversamplers[static_cast<size_t>(order - 1)].get() : nullptr;
+        }
+        
+        // the chains own parameters and coefficients, the engine runs every channel in one pass.
+        BiquadEngine<SampleType, ChainHelpers::numberOfSections> filterEngine;
+        
+        // 2x and 4x
+        std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, GlobalParameters::maxOversamplingOrder> oversamplers;
+        
+        // left and right of the output meters
+        TruePeakDetector<SampleType> truePeakDetectors[2];
+    };
+    
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer, ProcessingState<SampleType>& state);
+    template <typename SampleType>
+    void changeOversamplingOrder(int newOrder, ProcessingState<SampleType>& state);
+    template <typename SampleType>
+    void changePhaseMode(bool linear, ProcessingState<SampleType>& state);
+    
+    // message thread, tells the host the latency of whichever path the parameters pick
+    void updateLatency();
+
+    // message thread, gets linearPhaseFilter ready when linear phase is switched on
+    void phaseModeChanged();
+    
+    // the rate the filters are designed for and run at
+    double getProcessingSampleRate() const { return getSampleRate() * (1 << oversamplingOrder.load()); }
+    
     void initializeFilters(ChainHelpers::MonoFilterChain& chain, Channel channel, double sampleRate);
+    template <typename EngineType>
+    void loadFilterEngine(EngineType& engine);
     void performInnerLoopUpdate(int samplesToSkip);
-    void performPreLoopUpdate(ChannelMode mode, double sampleRate);
-    void updateTrims();
+    
+    // Runs the engine over the block, in one go once every band has settled.  While some are still
+    // moving the block is cut every maxSmoothingSegment samples, twice that with the matched designs,
+    // so the coefficients follow the smoothers rather than one straight line across a long block.
+    template <typename EngineType, typename SampleType>
+    void processFilters(EngineType& engine, SampleType* const* channels, int numChannels, int numSamples);
+    static constexpr int maxSmoothingSegment = 128;
+    bool performPreLoopUpdate(ChannelMode mode, double sampleRate, int numSamples);
     
     
     void addFilterParamToLayout(ParamLayout&, Channel, ChainPosition, bool);
     void createFilterLayouts(ParamLayout& layout, Channel channel);
-    
-    void performMidSideTransform(juce::AudioBuffer<float>&);
  
     ParamLayout createParameterLayout();
+    
+    // what the audio thread reads the parameters through, built from apvts above
+    ParameterTable parameterTable {apvts};
+    BandChangeMask changedBands {apvts};
+    AutomationRamps automationRamps;
+    
+    // The bands the inner loop still has work for, both channels' bits for a band that has any.  Set
+    // by the pre-loop update, cleared once both of a band's links have settled.
+    BandChangeMask::Mask activeBands {BandChangeMask::allBands};
+    ChannelMode lastMode {ChannelMode::Stereo};
+    bool lastMatchedDesign {false};
+    
+    // Up to third order ambisonics or 9.1.6.  Past stereo the channels are linked, all of them run the
+    // left channel's parameters, and only the first two are metered and analyzed.
+    static constexpr int maxChannels = 16;
+    
+    // the main bus as of prepareToPlay
+    int numBusChannels {2};
+    
+    // The order the chains and the engine are set up for, and whether the samples go through
+    // linearPhaseFilter instead of the engine.  Only the audio thread changes them after prepareToPlay,
+    // the message thread reads them too.
+    std::atomic<int> oversamplingOrder {0};
+    std::atomic<bool> linearPhase {false};
+    LinearPhaseFilter linearPhaseFilter {parameterTable};
+    
+    // latency of each order, worked out in prepareToPlay.  The host is told about a change from
+    // the message thread, the audio thread just switches.
+    std::array<std::atomic<int>, GlobalParameters::maxOversamplingOrder + 1> oversamplingLatency {};
+    ParamListener oversamplingListener {apvts.getParameter(GlobalParameters::oversamplingName), [this](float) { updateLatency(); }};
+    ParamListener phaseModeListener {apvts.getParameter(GlobalParameters::phaseModeName), [this](float) { phaseModeChanged(); }};
+    
     ChainHelpers::MonoFilterChain leftChain, rightChain;
-    Trim inputTrim, outputTrim;
+    
+    ProcessingState<float> floatProcessing;
+    ProcessingState<double> doubleProcessing;
+    
+    SilenceDetector silenceDetector;
+    std::atomic<double> tailLengthSeconds {0.0};
+    static constexpr double maxTailLengthSeconds {5.0};
     
     juce::ListenerList<SampleRateListener> sampleRateListeners;
     
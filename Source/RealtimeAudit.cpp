@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.cpp
+    Created: 18 Oct 2026 8:20:33pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "RealtimeAudit.h"
+
+#if REALTIME_AUDIT
+ #include <algorithm>
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdlib>
+ #include <new>
+ #if JUCE_LINUX
+  #include <dlfcn.h>
+  #include <pthread.h>
+ #endif
+#endif
+
+namespace RealtimeAudit
+{
+
+#if REALTIME_AUDIT
+
+namespace
+{
+    // Plain values, so the hooks can use them before any constructor has run.  reporting stops the
+    // allocations and locks made while recording a violation from being recorded themselves.
+    thread_local int realtimeDepth {0};
+    thread_local bool reporting {false};
+
+    juce::CriticalSection& getViolationLock()
+    {
+        static juce::CriticalSection lock;
+        return lock;
+    }
+
+    std::vector<Violation>& getViolationList()
+    {
+        static std::vector<Violation> violations;
+        return violations;
+    }
+
+    void report(ViolationType type)
+    {
+        if(realtimeDepth == 0 || reporting)
+            return;
+
+        reporting = true;
+
+        auto stackTrace = juce::SystemStats::getStackBacktrace();
+
+        {
+            const juce::ScopedLock lock(getViolationLock());
+            auto& violations = getViolationList();
+
+            auto existing = std::find_if(violations.begin(), violations.end(), [&](const Violation& violation)
+            {
+                return violation.type == type && violation.stackTrace == stackTrace;
+            });
+
+            if(existing != violations.end())
+                ++existing->count;
+            else
+                violations.push_back({type, stackTrace, 1});
+        }
+
+        reporting = false;
+    }
+}
+
+ScopedRealtimeThread::ScopedRealtimeThread()
+{
+    ++realtimeDepth;
+}
+
+ScopedRealtimeThread::~ScopedRealtimeThread()
+{
+    --realtimeDepth;
+}
+
+std::vector<Violation> getViolations()
+{
+    // the copy allocates, which is fine on whichever thread asks but must not count against it.
+    auto wasReporting = reporting;
+    reporting = true;
+
+    std::vector<Violation> copy;
+
+    {
+        const juce::ScopedLock lock(getViolationLock());
+        copy = getViolationList();
+    }
+
+    reporting = wasReporting;
+    return copy;
+}
+
+void clearViolations()
+{
+    auto wasReporting = reporting;
+    reporting = true;
+
+    {
+        const juce::ScopedLock lock(getViolationLock());
+        getViolationList().clear();
+    }
+
+    reporting = wasReporting;
+}
+
+#else
+
+std::vector<Violation> getViolations()
+{
+    return {};
+}
+
+void clearViolations()
+{
+}
+
+#endif
+
+juce::String getTypeName(ViolationType type)
+{
+    switch(type)
+    {
+        case ViolationType::Allocation:     return "allocation";
+        case ViolationType::Deallocation:   return "deallocation";
+        case ViolationType::Lock:           return "lock";
+    }
+
+    return {};
+}
+
+}
+
+#if REALTIME_AUDIT
+
+//==============================================================================
+// the replacement allocator, plain malloc and free underneath.
+
+namespace
+{
+    constexpr std::size_t defaultAlignment = alignof(std::max_align_t);
+
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        RealtimeAudit::report(RealtimeAudit::ViolationType::Allocation);
+
+        if(size == 0)
+            size = 1;
+
+        if(alignment <= defaultAlignment)
+            return std::malloc(size);
+
+        void* ptr = nullptr;
+
+       #if JUCE_WINDOWS
+        ptr = _aligned_malloc(size, alignment);
+       #else
+        if(posix_memalign(&ptr, alignment, size) != 0)
+            ptr = nullptr;
+       #endif
+
+        return ptr;
+    }
+
+    void* allocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        if(auto* ptr = allocate(size, alignment))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+
+    void deallocate(void* ptr, std::size_t alignment)
+    {
+        if(ptr == nullptr)
+            return;
+
+        RealtimeAudit::report(RealtimeAudit::ViolationType::Deallocation);
+
+       #if JUCE_WINDOWS
+        if(alignment > defaultAlignment)
+        {
+            _aligned_free(ptr);
+            return;
+        }
+       #else
+        juce::ignoreUnused(alignment);
+       #endif
+
+        std::free(ptr);
+    }
+}
+
+void* operator new(std::size_t size)                                                { return allocateOrThrow(size, defaultAlignment); }
+void* operator new[](std::size_t size)                                              { return allocateOrThrow(size, defaultAlignment); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept                { return allocate(size, defaultAlignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept              { return allocate(size, defaultAlignment); }
+void* operator new(std::size_t size, std::align_val_t align)                        { return allocateOrThrow(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align)                      { return allocateOrThrow(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept   { return allocate(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void* ptr) noexcept                                            { deallocate(ptr, defaultAlignment); }
+void operator delete[](void* ptr) noexcept                                          { deallocate(ptr, defaultAlignment); }
+void operator delete(void* ptr, std::size_t) noexcept                               { deallocate(ptr, defaultAlignment); }
+void operator delete[](void* ptr, std::size_t) noexcept                             { deallocate(ptr, defaultAlignment); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept                     { deallocate(ptr, defaultAlignment); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept                   { deallocate(ptr, defaultAlignment); }
+void operator delete(void* ptr, std::align_val_t align) noexcept                    { deallocate(ptr, static_cast<std::size_t>(align)); }
+void operator delete[](void* ptr, std::align_val_t align) noexcept                  { deallocate(ptr, static_cast<std::size_t>(align)); }
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept       { deallocate(ptr, static_cast<std::size_t>(align)); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t align) noexcept     { deallocate(ptr, static_cast<std::size_t>(align)); }
+void operator delete(void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept   { deallocate(ptr, static_cast<std::size_t>(align)); }
+void operator delete[](void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept { deallocate(ptr, static_cast<std::size_t>(align)); }
+
+//==============================================================================
+// Locks.  An executable's definition of pthread_mutex_lock takes precedence over libc's for every
+// library in the process on Linux, macOS binds each library to its own imports so this is Linux only.
+#if JUCE_LINUX
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    using LockFunction = int (*)(pthread_mutex_t*);
+
+    // constant initialised rather than a function static, whose guard could end up back in here
+    static std::atomic<LockFunction> realLock {nullptr};
+
+    auto lock = realLock.load(std::memory_order_relaxed);
+
+    if(lock == nullptr)
+    {
+        lock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        realLock.store(lock, std::memory_order_relaxed);
+    }
+
+    RealtimeAudit::report(RealtimeAudit::ViolationType::Lock);
+    return lock(mutex);
+}
+
+#endif
+
+#endif
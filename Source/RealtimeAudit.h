@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.h
+    Created: 18 Oct 2026 8:20:33pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include <JuceHeader.h>
+
+// Build with REALTIME_AUDIT=1, as the benchmark's Audit configuration does, to trap heap and lock
+// traffic on the audio thread.  Global operator new and delete are replaced, and on Linux so is
+// pthread_mutex_lock, which is what std::mutex, juce::CriticalSection and juce::WaitableEvent all end
+// up in.  Any of them called while a ScopedRealtimeThread is alive on the calling thread is recorded
+// as a violation, with a stack trace.
+//
+// Leave it off in the plugin itself, a host does not want its allocator replaced, and in anything
+// timed, the numbers would include the bookkeeping.
+#ifndef REALTIME_AUDIT
+ #define REALTIME_AUDIT 0
+#endif
+
+namespace RealtimeAudit
+{
+    enum class ViolationType
+    {
+        Allocation,
+        Deallocation,
+        Lock
+    };
+
+    // violations with the same type and stack trace are counted together
+    struct Violation
+    {
+        ViolationType type;
+        juce::String stackTrace;
+        int count;
+    };
+
+    // Marks the calling thread as real time for as long as it lives.  Costs nothing when the audit is off.
+    struct ScopedRealtimeThread
+    {
+       #if REALTIME_AUDIT
+        ScopedRealtimeThread();
+        ~ScopedRealtimeThread();
+       #endif
+    };
+
+    constexpr bool isCompiledIn() { return REALTIME_AUDIT != 0; }
+
+    std::vector<Violation> getViolations();
+    void clearViolations();
+
+    juce::String getTypeName(ViolationType type);
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    RealtimeSemaphore.cpp
+    Created: 19 Oct 2026 4:52:17am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#include "RealtimeSemaphore.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#else
+ #include <cerrno>
+#endif
+
+#if JUCE_MAC || JUCE_IOS
+
+RealtimeSemaphore::RealtimeSemaphore() : semaphore {dispatch_semaphore_create(0)}
+{
+    jassert(semaphore != nullptr);
+}
+
+RealtimeSemaphore::~RealtimeSemaphore()
+{
+    dispatch_release(semaphore);
+}
+
+void RealtimeSemaphore::signal()
+{
+    dispatch_semaphore_signal(semaphore);
+}
+
+void RealtimeSemaphore::wait()
+{
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+}
+
+#elif JUCE_WINDOWS
+
+RealtimeSemaphore::RealtimeSemaphore() : semaphore {CreateSemaphore(nullptr, 0, LONG_MAX, nullptr)}
+{
+    jassert(semaphore != nullptr);
+}
+
+RealtimeSemaphore::~RealtimeSemaphore()
+{
+    CloseHandle(semaphore);
+}
+
+void RealtimeSemaphore::signal()
+{
+    ReleaseSemaphore(semaphore, 1, nullptr);
+}
+
+void RealtimeSemaphore::wait()
+{
+    WaitForSingleObject(semaphore, INFINITE);
+}
+
+#else
+
+RealtimeSemaphore::RealtimeSemaphore()
+{
+    auto result = sem_init(&semaphore, 0, 0);
+    jassert(result == 0);
+    juce::ignoreUnused(result);
+}
+
+RealtimeSemaphore::~RealtimeSemaphore()
+{
+    sem_destroy(&semaphore);
+}
+
+void RealtimeSemaphore::signal()
+{
+    sem_post(&semaphore);
+}
+
+void RealtimeSemaphore::wait()
+{
+    // a signal handler landing on the thread interrupts the wait without a signal to take
+    while(sem_wait(&semaphore) != 0 && errno == EINTR)
+        ;
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    RealtimeSemaphore.h
+    Created: 19 Oct 2026 4:52:17am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#if JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#elif ! JUCE_WINDOWS
+ #include <semaphore.h>
+#endif
+
+// A counting semaphore the audio thread can signal.  juce::WaitableEvent and juce::Thread::notify
+// take a lock, this goes straight to the system's own semaphore, which is an atomic add and, only if
+// someone is waiting, a system call to wake them.  Every signal lets one wait through.
+class RealtimeSemaphore
+{
+public:
+    RealtimeSemaphore();
+    ~RealtimeSemaphore();
+
+    // any thread, never blocks
+    void signal();
+
+    // blocks until there's a signal to take
+    void wait();
+
+private:
+   #if JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_t semaphore;
+   #elif JUCE_WINDOWS
+    void* semaphore;
+   #else
+    sem_t semaphore;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeSemaphore)
+};
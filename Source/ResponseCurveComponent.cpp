@@ -18,14 +18,6 @@ using namespace ChainHelpers;
 ResponseCurveComponent::ResponseCurveComponent(double sr, juce::AudioProcessorValueTreeState& apvtsIn) : apvts{apvtsIn}, sampleRate{sr}
 {
     allParamsListener.reset( new AllParamsListener(apvts, std::bind( &ResponseCurveComponent::refreshParams, this)));
-    
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = 1024;
-    spec.numChannels = 1;
-    spec.sampleRate = sampleRate;
-    
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
 }
 
 void ResponseCurveComponent::paint(juce::Graphics& g)
@@ -73,8 +65,11 @@ void ResponseCurveComponent::buildNewResponseCurves()
 
 void ResponseCurveComponent::updateChainParameters()
 {
-    ChainHelpers::initializeFilters(leftChain, Channel::Left, apvts, 0.0, false, sampleRate);
-    ChainHelpers::initializeFilters(rightChain, Channel::Right, apvts, 0.0, false, sampleRate);
+    // designed at the rate the processor runs them at, so oversampling shows as the uncramped curve it is
+    auto processingSampleRate = sampleRate * (1 << static_cast<int>(parameters.getOversampling()));
+    
+    ChainHelpers::initializeFilters(leftChain, Channel::Left, parameters, 0.0, false, processingSampleRate);
+    ChainHelpers::initializeFilters(rightChain, Channel::Right, parameters, 0.0, false, processingSampleRate);
 }
 
  
@@ -87,17 +82,8 @@ std::vector<float> ResponseCurveComponent::buildNewResponseCurve(MonoFilterChain
     
     for(size_t x = 0; x < w; ++x )
     {
-        double mag {1.0};
         double freq = juce::mapToLog10(static_cast<double>(x) / w, 20.0, 20000.0);
-        
-        mag *= chain.get<0>().isBypassed() ? 1.0 : chain.get<0>().getCutFilterMagnitudeForFrequency(freq);
-        mag *= chain.get<1>().isBypassed() ? 1.0 : chain.get<1>().getFilterMagnitudeForFrequency(freq);
-        mag *= chain.get<2>().isBypassed() ? 1.0 : chain.get<2>().getFilterMagnitudeForFrequency(freq);
-        mag *= chain.get<3>().isBypassed() ? 1.0 : chain.get<3>().getFilterMagnitudeForFrequency(freq);
-        mag *= chain.get<4>().isBypassed() ? 1.0 : chain.get<4>().getFilterMagnitudeForFrequency(freq);
-        mag *= chain.get<5>().isBypassed() ? 1.0 : chain.get<5>().getFilterMagnitudeForFrequency(freq);
-        mag *= chain.get<6>().isBypassed() ? 1.0 : chain.get<6>().getFilterMagnitudeForFrequency(freq);
-        mag *= chain.get<7>().isBypassed() ? 1.0 : chain.get<7>().getCutFilterMagnitudeForFrequency(freq);
+        double mag = ChainHelpers::getMagnitudeForFrequency(chain, freq);
         
         path[x] = juce::Decibels::gainToDecibels(static_cast<float>(mag), NEGATIVE_INFINITY);
     }
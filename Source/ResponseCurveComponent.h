@@ -26,6 +26,7 @@ struct ResponseCurveComponent : AnalyzerBase
     
 private:
     juce::AudioProcessorValueTreeState& apvts;
+    ParameterTable parameters {apvts};
     double sampleRate;
     std::unique_ptr<AllParamsListener> allParamsListener;
     
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    SilenceDetector.h
+    Created: 18 Oct 2026 5:06:44pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Counts how long the input has been silent, so processBlock can go to sleep once the filters
+// have rung out as well.
+struct SilenceDetector
+{
+    // -160 dB, anything quieter than this counts as digital silence.
+    static constexpr float threshold {1.0e-8f};
+
+    // how many silent samples in a row before hasBeenSilentLongEnough() returns true
+    void prepare(int requiredSilentSamples)
+    {
+        required = juce::jmax(1, requiredSilentSamples);
+        reset();
+    }
+
+    void reset()
+    {
+        silentSamples = 0;
+    }
+
+    // returns true if the whole buffer is silent
+    template <typename SampleType>
+    bool update(const juce::AudioBuffer<SampleType>& buffer)
+    {
+        auto numSamples = buffer.getNumSamples();
+
+        for(int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            if(buffer.getMagnitude(channel, 0, numSamples) > threshold)
+            {
+                silentSamples = 0;
+                return false;
+            }
+        }
+
+        silentSamples = juce::jmin(silentSamples + numSamples, required);
+        return true;
+    }
+
+    bool hasBeenSilentLongEnough() const
+    {
+        return silentSamples >= required;
+    }
+
+private:
+    int required {1};
+    int silentSamples {0};
+};
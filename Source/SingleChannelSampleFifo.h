@@ -10,7 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include "Fifo.h"
+#include "SpscRing.h"
 #include "ParameterHelpers.h"
 
 #define SINGLE_CHANNEL_BUFFER_FIFO_DEPTH 100
@@ -22,7 +22,9 @@ struct SingleChannelSampleFifo
     
     SingleChannelSampleFifo(Channel ch) : channelToUse {ch}, prepared {false} {}
     
-    void update(const BlockType& buffer)
+    // the source can be a double buffer, samples are converted on the way in.
+    template <typename SourceBlockType>
+    void update(const SourceBlockType& buffer)
     {
         if(!prepared.get())
             return;
@@ -32,21 +34,32 @@ struct SingleChannelSampleFifo
             auto* channelData = buffer.getReadPointer (static_cast<int>(channelToUse));
  
             for (auto i = 0; i < buffer.getNumSamples(); ++i)
-                pushNextSampleIntoFifo (channelData[i]);
+                pushNextSampleIntoFifo (static_cast<SampleType>(channelData[i]));
         }
     }
     
+    // Samples go straight into a claimed slot of the ring, which is handed over once it's full.  If the
+    // analyzer has fallen so far behind that there's no free slot they go into bufferToFill and are lost.
     void pushNextSampleIntoFifo(SampleType sample)
     {
         if (fifoIndex == size.get())
         {
-            bool success = audioBufferFifo.push(bufferToFill);
-            jassert(success);
-            juce::ignoreUnused(success);
+            if(filling != &bufferToFill)
+                audioBufferFifo.commit();
+            
+            filling = nullptr;
             fifoIndex = 0;
         }
         
-        auto writePointer = bufferToFill.getWritePointer(0);
+        if(filling == nullptr)
+        {
+            filling = audioBufferFifo.claim();
+            
+            if(filling == nullptr)
+                filling = &bufferToFill;
+        }
+        
+        auto writePointer = filling->getWritePointer(0);
     
         jassert(writePointer);
     
@@ -58,8 +71,13 @@ struct SingleChannelSampleFifo
         prepared.set(false);
         size.set(bufferSize);
         fifoIndex = 0;
+        filling = nullptr;
         bufferToFill.setSize(1, bufferSize, false, false, true);
-        audioBufferFifo.prepare(bufferSize,0);
+        audioBufferFifo.prepare([bufferSize](BlockType& slot)
+        {
+            slot.setSize(1, bufferSize, false, false, true);
+            slot.clear();
+        });
         prepared.set(true);
     }
     
@@ -71,9 +89,15 @@ struct SingleChannelSampleFifo
         return audioBufferFifo.getNumAvailableForReading();
     }
     
-    bool getAudioBuffer(BlockType& buf)
+    // the oldest complete buffer, read where it is, until releaseAudioBuffer() hands it back
+    const BlockType* getNextAudioBuffer()
+    {
+        return audioBufferFifo.front();
+    }
+    
+    void releaseAudioBuffer()
     {
-        return audioBufferFifo.pull(buf);
+        audioBufferFifo.pop();
     }
     
     bool isPrepared() const { return prepared.get(); }
@@ -82,8 +106,9 @@ struct SingleChannelSampleFifo
 private:
     Channel channelToUse;
     int fifoIndex = 0;
-    Fifo<BlockType, SINGLE_CHANNEL_BUFFER_FIFO_DEPTH> audioBufferFifo;
+    SpscRing<BlockType, SINGLE_CHANNEL_BUFFER_FIFO_DEPTH> audioBufferFifo;
     BlockType bufferToFill;
+    BlockType* filling = nullptr;
     juce::Atomic<bool> prepared = false;
     juce::Atomic<int> size = 0;
 };
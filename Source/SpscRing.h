@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    SpscRing.h
+    Created: 19 Oct 2026 5:02:44am
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Single producer, single consumer queue of up to Capacity values, lock free and wait free.
+//
+// The slots are live Ts that stay put, so the producer builds each value in its slot with claim() and
+// commit() and the consumer reads it there with front() and pop().  Buffers, vectors and paths sized
+// once in prepare() are reused from then on, nothing gets copied on the way through and nothing
+// allocates.  push(), pull() and exchange() are there for small values and for handing storage back
+// and forth.
+//
+// Each index is written by one side only and published with release, read by the other with acquire.
+// The two live on separate cache lines, each next to its owner's cached copy of the other index, so
+// the sides only touch each other's line when the ring looks full or empty to them.
+template <typename T, size_t Capacity>
+struct SpscRing
+{
+    static_assert(Capacity > 0, "SpscRing needs at least one slot");
+
+    size_t getSize() const noexcept    { return Capacity; }
+
+    // Message thread, before either side starts.  Calls prepareSlot(T&) on every slot, to size it.
+    template <typename Function>
+    void prepare(Function&& prepareSlot)
+    {
+        for(auto& slot : slots)
+            prepareSlot(slot);
+
+        writer.index.store(0, std::memory_order_relaxed);
+        writer.cachedOther = 0;
+        reader.index.store(0, std::memory_order_relaxed);
+        reader.cachedOther = 0;
+    }
+
+    //==========================================================================
+    // producer
+
+    // The slot the next value goes in, nullptr if the ring is full.  Stays the producer's until commit().
+    T* claim()
+    {
+        auto write = writer.index.load(std::memory_order_relaxed);
+
+        if(write - writer.cachedOther == Capacity)
+        {
+            writer.cachedOther = reader.index.load(std::memory_order_acquire);
+
+            if(write - writer.cachedOther == Capacity)
+                return nullptr;
+        }
+
+        return &slots[write % Capacity];
+    }
+
+    // publishes the slot from claim()
+    void commit()
+    {
+        writer.index.store(writer.index.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // builds the value in its slot from args, for Ts that are cheap to assign
+    template <typename... Args>
+    bool emplace(Args&&... args)
+    {
+        auto* slot = claim();
+        if(slot == nullptr)
+            return false;
+
+        *slot = T(std::forward<Args>(args)...);
+        commit();
+        return true;
+    }
+
+    bool push(const T& t)
+    {
+        auto* slot = claim();
+        if(slot == nullptr)
+            return false;
+
+        *slot = t;
+        commit();
+        return true;
+    }
+
+    size_t getAvailableSpace() const
+    {
+        return Capacity - (writer.index.load(std::memory_order_relaxed) - reader.index.load(std::memory_order_acquire));
+    }
+
+    //==========================================================================
+    // consumer
+
+    // The oldest value, nullptr if there isn't one.  Stays valid until pop().
+    const T* front()    { return getReadSlot(); }
+
+    // hands the slot from front() back to the producer
+    void pop()
+    {
+        reader.index.store(reader.index.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool pull(T& t)
+    {
+        auto* slot = front();
+        if(slot == nullptr)
+            return false;
+
+        t = *slot;
+        pop();
+        return true;
+    }
+
+    // Swaps t with the oldest value.  What t held goes back into the ring for the producer to reuse,
+    // so it has to be storage the producer can fill, the same size as the rest.
+    bool exchange(T& t)
+    {
+        auto* slot = getReadSlot();
+        if(slot == nullptr)
+            return false;
+
+        std::swap(t, *slot);
+        pop();
+        return true;
+    }
+
+    size_t getNumAvailableForReading() const
+    {
+        return writer.index.load(std::memory_order_acquire) - reader.index.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t cacheLineSize = 64;
+
+    T* getReadSlot()
+    {
+        auto read = reader.index.load(std::memory_order_relaxed);
+
+        if(read == reader.cachedOther)
+        {
+            reader.cachedOther = writer.index.load(std::memory_order_acquire);
+
+            if(read == reader.cachedOther)
+                return nullptr;
+        }
+
+        return &slots[read % Capacity];
+    }
+
+    // Counts every value ever written or read, so full and empty never look alike.  A 64 bit count
+    // takes centuries to wrap at any rate this sees.
+    struct alignas(cacheLineSize) Side
+    {
+        std::atomic<size_t> index {0};
+        size_t cachedOther {0};
+    };
+
+    Side writer, reader;
+    std::array<T, Capacity> slots;
+};
@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    StereoKernels.h
+    Created: 18 Oct 2026 10:31:26pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Single pass, in place operations on a left/right pair of channels, or on the one channel of a mono
+// bus.  Each one visits every sample once, so work that used to be separate sweeps over the block (a
+// trim, the mid/side transform and the meters' peak and RMS) costs one trip through memory.
+namespace StereoKernels
+{
+    // Calls op(left, right) on every frame, with SIMDRegisters where it can and plain samples
+    // elsewhere, so op has to work with both (a generic lambda doing arithmetic does).  The vector
+    // part needs both channels to reach SIMD alignment at the same frame, which they do in a
+    // juce::AudioBuffer's own allocation.  Anything else runs the whole block as plain samples.
+    template <typename SampleType, typename Operation>
+    void forEachFrame(SampleType* left, SampleType* right, int numSamples, Operation&& op)
+    {
+        using Register = juce::dsp::SIMDRegister<SampleType>;
+        constexpr int numLanes = static_cast<int>(Register::SIMDNumElements);
+
+        int i = 0;
+        auto head = static_cast<int>(Register::getNextSIMDAlignedPtr(left) - left);
+
+        if(Register::getNextSIMDAlignedPtr(right) - right == head)
+        {
+            for(head = juce::jmin(head, numSamples); i < head; ++i)
+                op(left[i], right[i]);
+
+            for(; i + numLanes <= numSamples; i += numLanes)
+            {
+                auto l = Register::fromRawArray(left + i);
+                auto r = Register::fromRawArray(right + i);
+                op(l, r);
+                l.copyToRawArray(left + i);
+                r.copyToRawArray(right + i);
+            }
+        }
+
+        for(; i < numSamples; ++i)
+            op(left[i], right[i]);
+    }
+
+    // forEachFrame for a single channel
+    template <typename SampleType, typename Operation>
+    void forEachSample(SampleType* samples, int numSamples, Operation&& op)
+    {
+        using Register = juce::dsp::SIMDRegister<SampleType>;
+        constexpr int numLanes = static_cast<int>(Register::SIMDNumElements);
+
+        int i = 0;
+
+        for(auto head = juce::jmin(static_cast<int>(Register::getNextSIMDAlignedPtr(samples) - samples), numSamples); i < head; ++i)
+            op(samples[i]);
+
+        for(; i + numLanes <= numSamples; i += numLanes)
+        {
+            auto x = Register::fromRawArray(samples + i);
+            op(x);
+            x.copyToRawArray(samples + i);
+        }
+
+        for(; i < numSamples; ++i)
+            op(samples[i]);
+    }
+
+    // what the meters want from a block, gathered in the same pass that changes it
+    template <typename SampleType>
+    struct Levels
+    {
+        SampleType leftPeak {0}, rightPeak {0};
+        SampleType leftSumOfSquares {0}, rightSumOfSquares {0};
+
+        static SampleType getRms(SampleType sumOfSquares, int numSamples)
+        {
+            return numSamples > 0 ? std::sqrt(sumOfSquares / static_cast<SampleType>(numSamples)) : 0;
+        }
+    };
+
+    // where a stage's mid/side transform sits.  The meters always see left and right, so an encode
+    // happens after the gain and the measurement, a decode before them.
+    enum class MidSide
+    {
+        None,
+        Encode,
+        Decode
+    };
+
+    namespace Detail
+    {
+        template <typename SampleType>
+        struct LevelAccumulator
+        {
+            using Register = juce::dsp::SIMDRegister<SampleType>;
+
+            void add(const Register& l, const Register& r)
+            {
+                vectorPeakLeft = Register::max(vectorPeakLeft, Register::abs(l));
+                vectorPeakRight = Register::max(vectorPeakRight, Register::abs(r));
+                vectorSumLeft += l * l;
+                vectorSumRight += r * r;
+            }
+
+            void add(SampleType l, SampleType r)
+            {
+                levels.leftPeak = juce::jmax(levels.leftPeak, std::abs(l));
+                levels.rightPeak = juce::jmax(levels.rightPeak, std::abs(r));
+                levels.leftSumOfSquares += l * l;
+                levels.rightSumOfSquares += r * r;
+            }
+
+            // a mono channel counts as the left
+            void add(const Register& x)
+            {
+                vectorPeakLeft = Register::max(vectorPeakLeft, Register::abs(x));
+                vectorSumLeft += x * x;
+            }
+
+            void add(SampleType x)
+            {
+                levels.leftPeak = juce::jmax(levels.leftPeak, std::abs(x));
+                levels.leftSumOfSquares += x * x;
+            }
+
+            Levels<SampleType> getLevels() const
+            {
+                auto result = levels;
+
+                for(size_t lane = 0; lane < Register::SIMDNumElements; ++lane)
+                {
+                    result.leftPeak = juce::jmax(result.leftPeak, vectorPeakLeft.get(lane));
+                    result.rightPeak = juce::jmax(result.rightPeak, vectorPeakRight.get(lane));
+                }
+
+                result.leftSumOfSquares += vectorSumLeft.sum();
+                result.rightSumOfSquares += vectorSumRight.sum();
+                return result;
+            }
+
+            Register vectorPeakLeft {Register::expand(0)}, vectorPeakRight {Register::expand(0)};
+            Register vectorSumLeft {Register::expand(0)}, vectorSumRight {Register::expand(0)};
+            Levels<SampleType> levels;
+        };
+
+        template <MidSide Transform, bool Measure, typename SampleType>
+        void processStage(SampleType* left, SampleType* right, int numSamples, SampleType gain, Levels<SampleType>* levels)
+        {
+            constexpr auto minus3dB = 1 / juce::MathConstants<SampleType>::sqrt2;
+            const auto decodeScale = gain * minus3dB;
+
+            LevelAccumulator<SampleType> accumulator;
+
+            forEachFrame(left, right, numSamples, [&](auto& l, auto& r)
+            {
+                if constexpr (Transform == MidSide::Decode)
+                {
+                    auto sum = (l + r) * decodeScale;
+                    auto difference = (l - r) * decodeScale;
+                    l = sum;
+                    r = difference;
+                }
+                else
+                {
+                    l = l * gain;
+                    r = r * gain;
+                }
+
+                if constexpr (Measure)
+                    accumulator.add(l, r);
+
+                if constexpr (Transform == MidSide::Encode)
+                {
+                    auto sum = (l + r) * minus3dB;
+                    auto difference = (l - r) * minus3dB;
+                    l = sum;
+                    r = difference;
+                }
+            });
+
+            if constexpr (Measure)
+                *levels = accumulator.getLevels();
+        }
+    }
+
+    // The mono version, gain and, when levels is not null, the meters.  The one channel is measured
+    // into both sides of levels, so the meters show it on both.
+    template <typename SampleType>
+    void processStage(SampleType* samples, int numSamples, SampleType gain, Levels<SampleType>* levels = nullptr)
+    {
+        if(levels == nullptr)
+        {
+            if(gain != static_cast<SampleType>(1))
+                juce::FloatVectorOperations::multiply(samples, gain, numSamples);
+            return;
+        }
+
+        Detail::LevelAccumulator<SampleType> accumulator;
+
+        forEachSample(samples, numSamples, [&](auto& x)
+        {
+            x = x * gain;
+            accumulator.add(x);
+        });
+
+        *levels = accumulator.getLevels();
+        levels->rightPeak = levels->leftPeak;
+        levels->rightSumOfSquares = levels->leftSumOfSquares;
+    }
+
+    // One pass that applies gain, optionally encodes or decodes mid/side, and, when levels is not
+    // null, measures the peak and sum of squares of each channel for the meters.
+    template <typename SampleType>
+    void processStage(SampleType* left, SampleType* right, int numSamples, SampleType gain, MidSide transform,
+                      Levels<SampleType>* levels = nullptr)
+    {
+        if(levels == nullptr)
+        {
+            switch(transform)
+            {
+                case MidSide::None:
+                    // nothing to fuse with, FloatVectorOperations does a plain gain at least as well
+                    if(gain != static_cast<SampleType>(1))
+                    {
+                        juce::FloatVectorOperations::multiply(left, gain, numSamples);
+                        juce::FloatVectorOperations::multiply(right, gain, numSamples);
+                    }
+                    return;
+                case MidSide::Encode:   return Detail::processStage<MidSide::Encode, false>(left, right, numSamples, gain, levels);
+                case MidSide::Decode:   return Detail::processStage<MidSide::Decode, false>(left, right, numSamples, gain, levels);
+            }
+        }
+
+        switch(transform)
+        {
+            case MidSide::None:     return Detail::processStage<MidSide::None, true>(left, right, numSamples, gain, levels);
+            case MidSide::Encode:   return Detail::processStage<MidSide::Encode, true>(left, right, numSamples, gain, levels);
+            case MidSide::Decode:   return Detail::processStage<MidSide::Decode, true>(left, right, numSamples, gain, levels);
+        }
+    }
+}
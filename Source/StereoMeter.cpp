@@ -46,6 +46,6 @@ void StereoMeter::resized()
 
 void StereoMeter::update(MeterValues values)
 {
-    leftMeter.update(values.leftPeakDb.getDb(), values.leftRmsDb.getDb());
-    rightMeter.update(values.rightPeakDb.getDb(), values.rightRmsDb.getDb());
+    leftMeter.update(values.leftPeakDb.getDb(), values.leftRmsDb.getDb(), values.leftTruePeakDb.getDb());
+    rightMeter.update(values.rightPeakDb.getDb(), values.rightRmsDb.getDb(), values.rightTruePeakDb.getDb());
 }
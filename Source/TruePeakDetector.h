@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.h
+    Created: 18 Oct 2026 11:14:52pm
+    Author:  Ronald Legere
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The peak of one channel's signal between its samples, as ITU-R BS.1770 measures it: 4x oversampled
+// through the standard's 48 tap interpolator, which splits into four 12 tap phases.  The phases are
+// what goes across the SIMD lanes, so one multiply-add per tap gives every oversampled point for
+// an input sample (two of them in double, with two lanes), with no upsampled buffer in between.
+//
+// The measurement is at least the sample peak, the interpolator alone can land slightly under it.
+template <typename SampleType>
+class TruePeakDetector
+{
+public:
+    static constexpr size_t numPhases = 4;
+    static constexpr size_t tapsPerPhase = 12;
+
+    TruePeakDetector()
+    {
+        // BS.1770-4 annex 2, phase by phase
+        static constexpr double interpolator[numPhases][tapsPerPhase]
+        {
+            { 0.0017089843750,  0.0109863281250, -0.0196533203125,  0.0332031250000, -0.0594482421875,  0.1373291015625,
+              0.9721679687500, -0.1022949218750,  0.0476074218750, -0.0266113281250,  0.0148925781250, -0.0083007812500 },
+            {-0.0291748046875,  0.0292968750000, -0.0517578125000,  0.0891113281250, -0.1665039062500,  0.4650878906250,
+              0.7797851562500, -0.2003173828125,  0.1015625000000, -0.0582275390625,  0.0330810546875, -0.0189208984375 },
+            {-0.0189208984375,  0.0330810546875, -0.0582275390625,  0.1015625000000, -0.2003173828125,  0.7797851562500,
+              0.4650878906250, -0.1665039062500,  0.0891113281250, -0.0517578125000,  0.0292968750000, -0.0291748046875 },
+            {-0.0083007812500,  0.0148925781250, -0.0266113281250,  0.0476074218750, -0.1022949218750,  0.9721679687500,
+              0.1373291015625, -0.0594482421875,  0.0332031250000, -0.0196533203125,  0.0109863281250,  0.0017089843750 }
+        };
+
+        for(size_t tap = 0; tap < tapsPerPhase; ++tap)
+        {
+            for(size_t reg = 0; reg < numRegisters; ++reg)
+            {
+                SampleType lanes[numLanes];
+
+                for(size_t lane = 0; lane < numLanes; ++lane)
+                    lanes[lane] = static_cast<SampleType>(interpolator[reg * numLanes + lane][tap]);
+
+                coefficients[tap][reg] = Register::fromRawArray(lanes);
+            }
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(std::begin(history), std::end(history), static_cast<SampleType>(0));
+        position = 0;
+    }
+
+    // the largest absolute value among the block's samples and the points in between them
+    SampleType process(const SampleType* samples, int numSamples)
+    {
+        Register peaks[numRegisters];
+        for(auto& peak : peaks)
+            peak = Register::expand(0);
+
+        SampleType samplePeak {0};
+
+        for(int i = 0; i < numSamples; ++i)
+        {
+            auto sample = samples[i];
+            samplePeak = juce::jmax(samplePeak, std::abs(sample));
+
+            // every sample is written twice, so the newest tapsPerPhase of them always sit side by side
+            position = position == 0 ? tapsPerPhase - 1 : position - 1;
+            history[position] = history[position + tapsPerPhase] = sample;
+
+            const auto* window = history + position;
+
+            for(size_t reg = 0; reg < numRegisters; ++reg)
+            {
+                auto sum = coefficients[0][reg] * window[0];
+
+                for(size_t tap = 1; tap < tapsPerPhase; ++tap)
+                    sum += coefficients[tap][reg] * window[tap];
+
+                peaks[reg] = Register::max(peaks[reg], Register::abs(sum));
+            }
+        }
+
+        auto truePeak = samplePeak;
+
+        for(const auto& peak : peaks)
+            for(size_t lane = 0; lane < numLanes; ++lane)
+                truePeak = juce::jmax(truePeak, peak.get(lane));
+
+        return truePeak;
+    }
+
+private:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Register::SIMDNumElements;
+    static constexpr size_t numRegisters = numPhases / numLanes;
+
+    static_assert(numPhases % numLanes == 0, "the phases have to fill whole registers");
+
+    Register coefficients[tapsPerPhase][numRegisters];
+    SampleType history[2 * tapsPerPhase];
+    size_t position {0};
+};